@@ -0,0 +1,255 @@
+//////////////////////////////////////////////////////////////////////
+// beswap.cpp -- Bulk Big Endian to Host Order Conversion
+// Date: Sun Oct 18 23:59:31 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include "beswap.hpp"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BE_HOST	1			// Nothing to swap
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BE_X86	1
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define BE_NEON	1
+#include <arm_neon.h>
+#endif
+
+static std::atomic<BeSwapKind> kind(be_scalar);
+
+//////////////////////////////////////////////////////////////////////
+// Pick the best kernels on first use
+//////////////////////////////////////////////////////////////////////
+
+static void
+select_best() {
+	if ( !be_swap_select(be_avx2) && !be_swap_select(be_ssse3)
+	  && !be_swap_select(be_neon) )
+		be_swap_select(be_scalar);
+}
+
+static void
+be_swap32_init(void *to,const uint8_t *from,size_t n) {
+	select_best();
+	be_swap32(to,from,n);
+}
+
+static void
+be_swap64_init(void *to,const uint8_t *from,size_t n) {
+	select_best();
+	be_swap64(to,from,n);
+}
+
+std::atomic<beswap_t> be_swap32_fn(be_swap32_init);
+std::atomic<beswap_t> be_swap64_fn(be_swap64_init);
+
+//////////////////////////////////////////////////////////////////////
+// Portable kernels (also the tails of the vector kernels)
+//////////////////////////////////////////////////////////////////////
+
+void
+be_swap32_scalar(void *to,const uint8_t *from,size_t n) {
+	uint8_t *dp = (uint8_t *)to;
+	uint32_t v;
+
+	for ( size_t x=0; x<n; ++x ) {
+		memcpy(&v,from + x * 4,4);
+#ifndef BE_HOST
+		v = __builtin_bswap32(v);
+#endif
+		memcpy(dp + x * 4,&v,4);
+	}
+}
+
+void
+be_swap64_scalar(void *to,const uint8_t *from,size_t n) {
+	uint8_t *dp = (uint8_t *)to;
+	uint64_t v;
+
+	for ( size_t x=0; x<n; ++x ) {
+		memcpy(&v,from + x * 8,8);
+#ifndef BE_HOST
+		v = __builtin_bswap64(v);
+#endif
+		memcpy(dp + x * 8,&v,8);
+	}
+}
+
+#ifdef BE_X86
+
+//////////////////////////////////////////////////////////////////////
+// x86: one byte shuffle reverses every 4 or 8 byte lane
+//////////////////////////////////////////////////////////////////////
+
+__attribute__((target("ssse3")))
+static void
+be_swap32_ssse3(void *to,const uint8_t *from,size_t n) {
+	const __m128i rev = _mm_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12);
+	uint8_t *dp = (uint8_t *)to;
+	size_t x = 0;
+
+	for ( ; x + 4 <= n; x += 4 ) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(from + x * 4));
+
+		_mm_storeu_si128((__m128i *)(dp + x * 4),_mm_shuffle_epi8(v,rev));
+	}
+	be_swap32_scalar(dp + x * 4,from + x * 4,n - x);
+}
+
+__attribute__((target("ssse3")))
+static void
+be_swap64_ssse3(void *to,const uint8_t *from,size_t n) {
+	const __m128i rev = _mm_setr_epi8(7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+	uint8_t *dp = (uint8_t *)to;
+	size_t x = 0;
+
+	for ( ; x + 2 <= n; x += 2 ) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(from + x * 8));
+
+		_mm_storeu_si128((__m128i *)(dp + x * 8),_mm_shuffle_epi8(v,rev));
+	}
+	be_swap64_scalar(dp + x * 8,from + x * 8,n - x);
+}
+
+__attribute__((target("avx2")))
+static void
+be_swap32_avx2(void *to,const uint8_t *from,size_t n) {
+	const __m256i rev = _mm256_setr_epi8(
+		3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12,
+		3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12);
+	uint8_t *dp = (uint8_t *)to;
+	size_t x = 0;
+
+	for ( ; x + 8 <= n; x += 8 ) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(from + x * 4));
+
+		_mm256_storeu_si256((__m256i *)(dp + x * 4),_mm256_shuffle_epi8(v,rev));
+	}
+	_mm256_zeroupper();
+	for ( ; x + 4 <= n; x += 4 ) {		// VEX encoded: no SSE/AVX switch
+		__m128i v = _mm_loadu_si128((const __m128i *)(from + x * 4));
+
+		_mm_storeu_si128((__m128i *)(dp + x * 4),
+			_mm_shuffle_epi8(v,_mm256_castsi256_si128(rev)));
+	}
+	be_swap32_scalar(dp + x * 4,from + x * 4,n - x);
+}
+
+__attribute__((target("avx2")))
+static void
+be_swap64_avx2(void *to,const uint8_t *from,size_t n) {
+	const __m256i rev = _mm256_setr_epi8(
+		7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8,
+		7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+	uint8_t *dp = (uint8_t *)to;
+	size_t x = 0;
+
+	for ( ; x + 4 <= n; x += 4 ) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(from + x * 8));
+
+		_mm256_storeu_si256((__m256i *)(dp + x * 8),_mm256_shuffle_epi8(v,rev));
+	}
+	_mm256_zeroupper();
+	for ( ; x + 2 <= n; x += 2 ) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(from + x * 8));
+
+		_mm_storeu_si128((__m128i *)(dp + x * 8),
+			_mm_shuffle_epi8(v,_mm256_castsi256_si128(rev)));
+	}
+	be_swap64_scalar(dp + x * 8,from + x * 8,n - x);
+}
+
+#endif // BE_X86
+
+#ifdef BE_NEON
+
+//////////////////////////////////////////////////////////////////////
+// ARM: rev32/rev64 reverse the bytes of every lane
+//////////////////////////////////////////////////////////////////////
+
+static void
+be_swap32_neon(void *to,const uint8_t *from,size_t n) {
+	uint8_t *dp = (uint8_t *)to;
+	size_t x = 0;
+
+	for ( ; x + 4 <= n; x += 4 )
+		vst1q_u8(dp + x * 4,vrev32q_u8(vld1q_u8(from + x * 4)));
+	be_swap32_scalar(dp + x * 4,from + x * 4,n - x);
+}
+
+static void
+be_swap64_neon(void *to,const uint8_t *from,size_t n) {
+	uint8_t *dp = (uint8_t *)to;
+	size_t x = 0;
+
+	for ( ; x + 2 <= n; x += 2 )
+		vst1q_u8(dp + x * 8,vrev64q_u8(vld1q_u8(from + x * 8)));
+	be_swap64_scalar(dp + x * 8,from + x * 8,n - x);
+}
+
+#endif // BE_NEON
+
+//////////////////////////////////////////////////////////////////////
+// Select the kernels in use
+//////////////////////////////////////////////////////////////////////
+
+bool
+be_swap_select(BeSwapKind k) {
+
+	switch ( k ) {
+	case be_scalar :
+		be_swap32_fn = be_swap32_scalar;
+		be_swap64_fn = be_swap64_scalar;
+		break;
+#ifdef BE_X86
+	case be_ssse3 :
+		if ( !__builtin_cpu_supports("ssse3") )
+			return false;
+		be_swap32_fn = be_swap32_ssse3;
+		be_swap64_fn = be_swap64_ssse3;
+		break;
+	case be_avx2 :
+		if ( !__builtin_cpu_supports("avx2") )
+			return false;
+		be_swap32_fn = be_swap32_avx2;
+		be_swap64_fn = be_swap64_avx2;
+		break;
+#endif
+#ifdef BE_NEON
+	case be_neon :
+		be_swap32_fn = be_swap32_neon;
+		be_swap64_fn = be_swap64_neon;
+		break;
+#endif
+	default :
+		return false;
+	}
+	kind = k;
+	return true;
+}
+
+BeSwapKind
+be_swap_kind() {
+	if ( be_swap32_fn.load() == be_swap32_init )
+		select_best();
+	return kind;
+}
+
+const char *
+be_swap_name(BeSwapKind k) {
+	switch ( k ) {
+	case be_scalar :
+		return "scalar";
+	case be_ssse3 :
+		return "ssse3";
+	case be_avx2 :
+		return "avx2";
+	case be_neon :
+		return "neon";
+	}
+	return "?";
+}
+
+// End beswap.cpp
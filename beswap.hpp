@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////
+// beswap.hpp -- Bulk Big Endian to Host Order Conversion
+// Date: Sun Oct 18 23:59:02 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef BESWAP_HPP
+#define BESWAP_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+enum BeSwapKind {
+	be_scalar,		// Portable bswap loop
+	be_ssse3,		// pshufb, 16 bytes at a time
+	be_avx2,		// vpshufb, 32 bytes at a time
+	be_neon			// rev32/rev64, 16 bytes at a time
+};
+
+//////////////////////////////////////////////////////////////////////
+// Convert n consecutive big endian 4 byte (be_swap32) or 8 byte
+// (be_swap64) values at from, which need not be aligned, into host
+// order at to. The best kernel supported by the CPU is used unless
+// another is chosen with be_swap_select(). As with dle_scan(), the
+// kernels are held in atomics so any thread may make the first call.
+//////////////////////////////////////////////////////////////////////
+
+typedef void (*beswap_t)(void *to,const uint8_t *from,size_t n);
+
+extern std::atomic<beswap_t> be_swap32_fn;	// Kernels in use
+extern std::atomic<beswap_t> be_swap64_fn;
+
+static inline void
+be_swap32(void *to,const uint8_t *from,size_t n) {
+	be_swap32_fn.load(std::memory_order_relaxed)(to,from,n);
+}
+
+static inline void
+be_swap64(void *to,const uint8_t *from,size_t n) {
+	be_swap64_fn.load(std::memory_order_relaxed)(to,from,n);
+}
+
+void be_swap32_scalar(void *to,const uint8_t *from,size_t n);
+void be_swap64_scalar(void *to,const uint8_t *from,size_t n);
+
+bool be_swap_select(BeSwapKind kind);	// False if not supported
+BeSwapKind be_swap_kind();
+const char *be_swap_name(BeSwapKind kind);
+
+static inline void
+be_floats(float *to,const uint8_t *from,size_t n) {
+	be_swap32(to,from,n);
+}
+
+static inline void
+be_doubles(double *to,const uint8_t *from,size_t n) {
+	be_swap64(to,from,n);
+}
+
+#endif // BESWAP_HPP
+
+// End beswap.hpp
@@ -0,0 +1,108 @@
+//////////////////////////////////////////////////////////////////////
+// cmdchan.cpp -- Command Channel (stdin commands off the receive path)
+// Date: Sun Oct 18 21:07:51 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+
+#include "cmdchan.hpp"
+
+CmdChannel::CmdChannel() : closed(false) {
+	pkt = 0;
+	handler = 0;
+	in_fd = -1;
+	stop_pipe[0] = stop_pipe[1] = -1;
+}
+
+CmdChannel::~CmdChannel() {
+	stop();
+	for ( int x=0; x<2; ++x )
+		if ( stop_pipe[x] >= 0 )
+			close(stop_pipe[x]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Start reading commands from fd, passing each byte to handler
+//
+// RETURNS:
+//	true	- Command thread running
+//	false	- Already started, or no pipe (see errno)
+//////////////////////////////////////////////////////////////////////
+
+bool
+CmdChannel::start(Packet& pkt,cmdcb_t handler,int fd) {
+
+	if ( worker.joinable() )
+		return false;
+	if ( stop_pipe[0] < 0 ) {
+		if ( pipe(stop_pipe) )
+			return false;
+		fcntl(stop_pipe[0],F_SETFD,FD_CLOEXEC);
+		fcntl(stop_pipe[1],F_SETFD,FD_CLOEXEC);
+	}
+
+	this->pkt = &pkt;
+	this->handler = handler;
+	in_fd = fd;
+	closed = false;
+	worker = std::thread(&CmdChannel::run,this);
+	return true;
+}
+
+void
+CmdChannel::stop() {
+	char c;
+
+	if ( !worker.joinable() )
+		return;
+	while ( write(stop_pipe[1],"",1) < 0 && errno == EINTR )
+		;				// Empty pipe: cannot block
+	worker.join();
+	while ( read(stop_pipe[0],&c,1) < 0 && errno == EINTR )
+		;				// Consume the wakeup
+}
+
+//////////////////////////////////////////////////////////////////////
+// Command thread: wait for input or stop(), run each command byte
+//////////////////////////////////////////////////////////////////////
+
+void
+CmdChannel::run() {
+	struct pollfd fds[2];
+	uint8_t cmds[64];
+	int rc;
+
+	fds[0].fd = in_fd;
+	fds[0].events = POLLIN;
+	fds[1].fd = stop_pipe[0];
+	fds[1].events = POLLIN;
+
+	for (;;) {
+		fds[0].revents = fds[1].revents = 0;
+		rc = poll(fds,2,-1);
+		if ( rc < 0 ) {
+			if ( errno == EINTR )
+				continue;
+			break;
+		}
+		if ( fds[1].revents )
+			return;				// stop()
+		if ( !fds[0].revents )
+			continue;
+
+		do	{
+			rc = read(in_fd,cmds,sizeof cmds);
+		} while ( rc < 0 && errno == EINTR );
+		if ( rc <= 0 )
+			break;				// EOF or error
+
+		for ( int x=0; x<rc; ++x )
+			handler(*pkt,char(cmds[x]));
+	}
+	closed = true;
+}
+
+// End cmdchan.cpp
@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////
+// cmdchan.hpp -- Command Channel (stdin commands off the receive path)
+// Date: Sun Oct 18 21:02:36 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef CMDCHAN_HPP
+#define CMDCHAN_HPP
+
+#include <atomic>
+#include <thread>
+
+#include "ttyio.hpp"
+
+typedef void (*cmdcb_t)(Packet& pkt,char ch);
+
+//////////////////////////////////////////////////////////////////////
+// Reads single character commands from an fd (stdin) on its own
+// thread and runs the handler there, so receiving never polls for
+// commands and a slow handler never stalls framing. The handler may
+// send with pkt.put() while another thread receives; it must not
+// receive itself. To shut down from a command, make the Packet's
+// cancel fd readable (see Packet::set_cancel()): the receiving
+// thread then sees EOF and can stop() the channel and clean up.
+//////////////////////////////////////////////////////////////////////
+
+class CmdChannel {
+	Packet	*pkt;		// Receiver commands are sent to
+	cmdcb_t	handler;	// Runs each command
+	int	in_fd;		// Command input
+	int	stop_pipe[2];	// Wakes the thread for stop()
+	std::thread worker;	// Command thread
+	std::atomic<bool> closed; // Command input at EOF
+
+protected:
+	void run();				// Command thread body
+
+public:	CmdChannel();
+	~CmdChannel();
+
+	bool start(Packet& pkt,cmdcb_t handler,int fd=0);
+	void stop();				// Stop and join the thread
+
+	inline bool at_eof() const { return closed; }
+};
+
+#endif // CMDCHAN_HPP
+
+// End cmdchan.hpp
@@ -0,0 +1,133 @@
+//////////////////////////////////////////////////////////////////////
+// dlescan.cpp -- Bulk DLE (0x10) Scanning
+// Date: Sun Oct 18 09:14:02 2026
+///////////////////////////////////////////////////////////////////////
+
+#include "dlescan.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DLE_X86	1
+#include <immintrin.h>
+#endif
+
+static std::atomic<DleScanKind> kind(dle_scalar);
+
+//////////////////////////////////////////////////////////////////////
+// Pick the best scanner on first use
+//////////////////////////////////////////////////////////////////////
+
+static void
+select_best() {
+	if ( !dle_scan_select(dle_avx2) && !dle_scan_select(dle_sse2) )
+		dle_scan_select(dle_scalar);
+}
+
+static size_t
+dle_scan_init(const uint8_t *data,size_t len) {
+	select_best();
+	return dle_scan_fn.load(std::memory_order_relaxed)(data,len);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Portable scanner (also the tail of the vector scanners)
+//////////////////////////////////////////////////////////////////////
+
+size_t
+dle_scan_scalar(const uint8_t *data,size_t len) {
+	size_t x;
+
+	for ( x=0; x<len; ++x )
+		if ( data[x] == 0x10 )
+			break;
+	return x;
+}
+
+#ifdef DLE_X86
+
+__attribute__((target("sse2")))
+static size_t
+dle_scan_sse2(const uint8_t *data,size_t len) {
+	const __m128i dle = _mm_set1_epi8(0x10);
+	size_t x = 0;
+
+	for ( ; x + 16 <= len; x += 16 ) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + x));
+		unsigned m = _mm_movemask_epi8(_mm_cmpeq_epi8(v,dle));
+
+		if ( m )
+			return x + __builtin_ctz(m);
+	}
+	return x + dle_scan_scalar(data + x,len - x);
+}
+
+__attribute__((target("avx2")))
+static size_t
+dle_scan_avx2(const uint8_t *data,size_t len) {
+	const __m256i dle = _mm256_set1_epi8(0x10);
+	size_t x = 0;
+
+	for ( ; x + 32 <= len; x += 32 ) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(data + x));
+		unsigned m = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v,dle));
+
+		if ( m )
+			return x + __builtin_ctz(m);
+	}
+	return x + dle_scan_sse2(data + x,len - x);
+}
+
+#endif // DLE_X86
+
+//////////////////////////////////////////////////////////////////////
+// Select the scanner in use
+//////////////////////////////////////////////////////////////////////
+
+bool
+dle_scan_select(DleScanKind k) {
+
+	switch ( k ) {
+	case dle_scalar :
+		dle_scan_fn = dle_scan_scalar;
+		break;
+#ifdef DLE_X86
+	case dle_sse2 :
+		if ( !__builtin_cpu_supports("sse2") )
+			return false;
+		dle_scan_fn = dle_scan_sse2;
+		break;
+	case dle_avx2 :
+		if ( !__builtin_cpu_supports("avx2") )
+			return false;
+		dle_scan_fn = dle_scan_avx2;
+		break;
+#endif
+	default :
+		return false;
+	}
+	kind = k;
+	return true;
+}
+
+DleScanKind
+dle_scan_kind() {
+	if ( dle_scan_fn.load() == dle_scan_init )
+		select_best();
+	return kind;
+}
+
+const char *
+dle_scan_name(DleScanKind k) {
+	switch ( k ) {
+	case dle_scalar :
+		return "scalar";
+	case dle_sse2 :
+		return "sse2";
+	case dle_avx2 :
+		return "avx2";
+	}
+	return "?";
+}
+
+std::atomic<dlescan_t> dle_scan_fn(dle_scan_init);
+
+// End dlescan.cpp
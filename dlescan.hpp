@@ -0,0 +1,44 @@
+//////////////////////////////////////////////////////////////////////
+// dlescan.hpp -- Bulk DLE (0x10) Scanning
+// Date: Sun Oct 18 09:12:40 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef DLESCAN_HPP
+#define DLESCAN_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+enum DleScanKind {
+	dle_scalar,		// Portable byte loop
+	dle_sse2,		// 16 bytes per compare
+	dle_avx2		// 32 bytes per compare
+};
+
+//////////////////////////////////////////////////////////////////////
+// Return the offset of the first 0x10 in data[0..len), or len if
+// there is none. The best scanner supported by the CPU is used
+// unless another is chosen with dle_scan_select(). Any thread may
+// make the first call: the scanner is held in an atomic, so the
+// lazy choice is not a data race (a relaxed load is a plain load).
+//////////////////////////////////////////////////////////////////////
+
+typedef size_t (*dlescan_t)(const uint8_t *data,size_t len);
+
+extern std::atomic<dlescan_t> dle_scan_fn;	// Scanner in use
+
+static inline size_t
+dle_scan(const uint8_t *data,size_t len) {
+	return dle_scan_fn.load(std::memory_order_relaxed)(data,len);
+}
+
+size_t dle_scan_scalar(const uint8_t *data,size_t len);
+
+bool dle_scan_select(DleScanKind kind);	// False if not supported
+DleScanKind dle_scan_kind();
+const char *dle_scan_name(DleScanKind kind);
+
+#endif // DLESCAN_HPP
+
+// End dlescan.hpp
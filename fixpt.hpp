@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////
+// fixpt.hpp -- Fixed Point Decoding of Fix Reports (no FPU needed)
+// Date: Mon Oct 19 00:36:12 2026
+///////////////////////////////////////////////////////////////////////
+//
+// get_fixed() decodes a position or velocity report straight into
+// scaled integers. The IEEE bits on the wire are taken apart with
+// integer shifts and multiplies only, so an AVR build that uses these
+// in place of get(s_R84&) etc. links no soft float code at all:
+//
+//	s_R84fx fix;
+//
+//	if ( get_fixed(rxpkt,fix) && fix.altitude > ceiling_mm )
+//		...
+//
+//	latitude, longitude	1e-7 degrees (the reports send radians)
+//	altitude		millimetres
+//	velocities		cm/s
+//	time_of_fix		milliseconds
+//
+// Results are rounded to the nearest unit and are within 1 unit of
+// the float path (rcheck's check_fixpt() tests edge and random values
+// under make check; trimble -D n compares on a capture). Values out
+// of int32_t range saturate; NaN gives 0.
+//////////////////////////////////////////////////////////////////////
+
+#ifndef FIXPT_HPP
+#define FIXPT_HPP
+
+#include <stdint.h>
+
+#include "tsip.hpp"
+#include "rxview.hpp"
+
+struct s_R4Afx {			// From s_R4A
+	int32_t		latitude;	// 1e-7 degrees
+	int32_t		longitude;	// 1e-7 degrees
+	int32_t		altitude;	// mm
+	int32_t		time_of_fix;	// ms
+};
+
+struct s_R56fx {			// From s_R56
+	int32_t		eastvel;	// cm/s
+	int32_t		northvel;	// cm/s
+	int32_t		upvel;		// cm/s
+	int32_t		time_of_fix;	// ms
+};
+
+struct s_R84fx {			// From s_R84
+	int32_t		latitude;	// 1e-7 degrees
+	int32_t		longitude;	// 1e-7 degrees
+	int32_t		altitude;	// mm
+	int32_t		time_of_fix;	// ms
+};
+
+//////////////////////////////////////////////////////////////////////
+// A scale factor K = mant * 2^exp, with bit 31 of mant set
+//////////////////////////////////////////////////////////////////////
+
+struct s_fxscale {
+	uint32_t	mant;
+	int8_t		exp;
+};
+
+static const s_fxscale fx_rad_deg7 = { 0x889A918Du, -2 };	// 180/pi * 1e7
+static const s_fxscale fx_milli = { 0xFA000000u, -22 };		// 1000
+static const s_fxscale fx_centi = { 0xC8000000u, -25 };		// 100
+
+//////////////////////////////////////////////////////////////////////
+// round(v * K), for v = m * 2^(e - 31) with bit 31 of m set
+//////////////////////////////////////////////////////////////////////
+
+static inline int32_t
+fx_scale(bool neg,uint32_t m,int e,const s_fxscale& k) {
+	uint64_t p = uint64_t(m) * k.mant;	// v * K = p * 2^-sh
+	int sh = 31 - e - k.exp;
+	uint64_t r;
+
+	if ( sh > 64 )
+		return 0;
+	if ( sh <= 1 )
+		r = ~uint64_t(0);		// At least 2^63: saturate
+	else	r = ((p >> (sh - 1)) + 1) >> 1;
+	if ( r > uint64_t(INT32_MAX) )
+		return neg ? INT32_MIN : INT32_MAX;
+	return neg ? -int32_t(r) : int32_t(r);
+}
+
+// Big endian single at p, times K
+static inline int32_t
+fx_single(const uint8_t *p,const s_fxscale& k) {
+	uint32_t u = be32(p);
+	unsigned ex = (u >> 23) & 0xFF;
+
+	if ( ex == 0 )				// Zero, or too small to matter
+		return 0;
+	if ( ex == 0xFF )			// Infinity, or NaN
+		return (u & 0x7FFFFF) ? 0 : (u >> 31) ? INT32_MIN : INT32_MAX;
+	return fx_scale(u >> 31,((u & 0x7FFFFF) | 0x800000) << 8,int(ex) - 127,k);
+}
+
+// Big endian double at p, times K (mantissa cut to 32 bits)
+static inline int32_t
+fx_double(const uint8_t *p,const s_fxscale& k) {
+	uint64_t u = be64(p);
+	unsigned ex = unsigned(u >> 52) & 0x7FF;
+
+	if ( ex == 0 )
+		return 0;
+	if ( ex == 0x7FF )
+		return (u & 0xFFFFFFFFFFFFFull) ? 0 : (u >> 63) ? INT32_MIN : INT32_MAX;
+	return fx_scale(u >> 63,uint32_t(((u & 0xFFFFFFFFFFFFFull) | (1ull << 52)) >> 21),int(ex) - 1023,k);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Decode at the packet's offset (after id()), as get() does
+//////////////////////////////////////////////////////////////////////
+
+inline bool
+get_fixed(RxPacket& pkt,s_R4Afx& recd) {
+	RxRecord<s_R4A> rec(pkt);
+	typedef RxRecord<s_R4A>::L L;
+	const uint8_t *p = rec.data();
+
+	if ( !p )
+		return false;
+	recd.latitude = fx_single(p + L::latitude::offset,fx_rad_deg7);
+	recd.longitude = fx_single(p + L::longitude::offset,fx_rad_deg7);
+	recd.altitude = fx_single(p + L::altitude::offset,fx_milli);
+	recd.time_of_fix = rec.is_double()
+		? fx_double(p + L::time_of_fix2::offset,fx_milli)
+		: fx_single(p + L::time_of_fix1::offset,fx_milli);
+	return true;
+}
+
+inline bool
+get_fixed(RxPacket& pkt,s_R56fx& recd) {
+	RxRecord<s_R56> rec(pkt);
+	typedef RxRecord<s_R56>::L L;
+	const uint8_t *p = rec.data();
+
+	if ( !p )
+		return false;
+	recd.eastvel = fx_single(p + L::eastvel::offset,fx_centi);
+	recd.northvel = fx_single(p + L::northvel::offset,fx_centi);
+	recd.upvel = fx_single(p + L::upvel::offset,fx_centi);
+	recd.time_of_fix = rec.is_double()
+		? fx_double(p + L::time_of_fix2::offset,fx_milli)
+		: fx_single(p + L::time_of_fix1::offset,fx_milli);
+	return true;
+}
+
+inline bool
+get_fixed(RxPacket& pkt,s_R84fx& recd) {
+	RxRecord<s_R84> rec(pkt);
+	typedef RxRecord<s_R84>::L L;
+	const uint8_t *p = rec.data();
+
+	if ( !p )
+		return false;
+	recd.latitude = fx_double(p + L::latitude::offset,fx_rad_deg7);
+	recd.longitude = fx_double(p + L::longitude::offset,fx_rad_deg7);
+	recd.altitude = fx_double(p + L::altitude::offset,fx_milli);
+	recd.time_of_fix = rec.is_double()
+		? fx_double(p + L::time_of_fix2::offset,fx_milli)
+		: fx_single(p + L::time_of_fix1::offset,fx_milli);
+	return true;
+}
+
+#endif // FIXPT_HPP
+
+// End fixpt.hpp
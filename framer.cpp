@@ -0,0 +1,248 @@
+//////////////////////////////////////////////////////////////////////
+// framer.cpp -- TSIP Packet Framing (push parser)
+// Date: Sun Oct 18 10:05:44 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <assert.h>
+
+#include "framer.hpp"
+#include "dlescan.hpp"
+
+TsipFramer::TsipFramer() {
+	buf = 0;
+	buflen = 0;
+	maxlen = 0;
+	state = fr_idle;
+	done = false;
+	end_ok = false;
+	callback = 0;
+	cbarg = 0;
+	rule = 0;
+	limit = minlen = 0;
+	ruled = 0;
+	resynced = false;
+	nstarts = 0;
+	memset(&fstats,0,sizeof fstats);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Supply the packet buffer (maxlen bytes)
+//////////////////////////////////////////////////////////////////////
+
+void
+TsipFramer::open(uint8_t *buf,int maxlen) {
+	this->buf = buf;
+	this->maxlen = maxlen;
+	reset();
+}
+
+void
+TsipFramer::reset() {
+	buflen = 0;
+	state = fr_idle;
+	done = false;
+	end_ok = false;
+	resynced = false;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Begin a packet; the next byte is its id
+//////////////////////////////////////////////////////////////////////
+
+void
+TsipFramer::start() {
+	buflen = 0;
+	limit = maxlen;
+	minlen = 0;
+	ruled = rule ? -1 : 0;
+	resynced = false;
+	state = fr_data;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Look up the length rule once enough of the packet is in
+//
+// RETURNS:
+//	true	- Length still valid
+//	false	- Already longer than the id allows
+//////////////////////////////////////////////////////////////////////
+
+bool
+TsipFramer::lookup() {
+	int mn, mx, r;
+
+	if ( ruled < 0 && (r = rule(buf,buflen,mn,mx)) >= 0 ) {
+		ruled = r;
+		if ( r > 0 ) {
+			minlen = mn;
+			if ( mx > 0 && mx < limit )
+				limit = mx;
+		}
+	}
+	return buflen <= limit;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Discard the packet being framed (and its DLE)
+//////////////////////////////////////////////////////////////////////
+
+void
+TsipFramer::drop() {
+	fstats.dropped += buflen + 1;
+	buflen = 0;
+	resynced = false;
+	state = fr_idle;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Deliver a completed packet
+//
+// RETURNS:
+//	true	- Packet handed to callback, keep going
+//	false	- No callback: stop so the caller can take it
+//////////////////////////////////////////////////////////////////////
+
+bool
+TsipFramer::complete(bool ended) {
+
+	state = fr_idle;
+	end_ok = ended;
+
+	if ( callback ) {
+		callback(cbarg,buf,buflen,ended);
+		buflen = 0;
+		return true;
+	}
+	done = true;
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Push len bytes into the framer
+//
+// Runs of non-DLE bytes are located with dle_scan() and copied in
+// one step; only the DLE boundaries go through the state machine.
+//
+// RETURNS:
+//	Number of bytes consumed (less than len only when a packet is
+//	ready and no callback is registered)
+//////////////////////////////////////////////////////////////////////
+
+size_t
+TsipFramer::feed(const uint8_t *data,size_t len) {
+	size_t x = 0, run, room;
+
+	if ( done )				// Previous packet taken
+		release();
+
+	while ( x < len ) {
+		switch ( state ) {
+		case fr_idle :
+			run = dle_scan(data+x,len-x);
+			fstats.dropped += run;		// Noise between packets
+			x += run;
+			if ( x < len ) {
+				++x;			// DLE
+				state = fr_start;
+				++nstarts;
+			}
+			break;
+		case fr_start :
+			if ( data[x] == 0x10 || data[x] == 0x03 ) {
+				++x;			// Stuffed DLE or DLE ETX:
+				fstats.dropped += 2;	// joined mid packet
+				state = fr_idle;
+			} else	start();		// Id: rescan in fr_data
+			break;
+		case fr_data :
+			run = dle_scan(data+x,len-x);
+			if ( run > 0 ) {
+				room = limit - buflen;
+				if ( run > room ) {	// discard packet -- too long
+					if ( limit < maxlen )
+						++fstats.rejected;
+					else	++fstats.overflows;
+					fstats.dropped += room;
+					x += room;
+					drop();
+					break;
+				}
+				memcpy(buf+buflen,data+x,run);
+				buflen += run;
+				x += run;
+				if ( ruled < 0 && !lookup() ) {
+					++fstats.rejected;
+					drop();
+					break;
+				}
+			}
+			if ( x < len ) {
+				++x;			// DLE
+				state = fr_escape;
+			}
+			break;
+		case fr_escape :
+			if ( data[x] == 0x10 ) {
+				++x;
+				if ( buflen >= limit ) { // discard packet -- too long
+					if ( limit < maxlen )
+						++fstats.rejected;
+					else	++fstats.overflows;
+					drop();
+					break;
+				}
+				buf[buflen++] = 0x10;
+				state = fr_data;
+				if ( ruled < 0 && !lookup() ) {
+					++fstats.rejected;
+					drop();
+				}
+			} else if ( data[x] == 0x03 ) {
+				++x;
+				if ( rule && (!lookup() || ruled < 0 || buflen < minlen) ) {
+					++fstats.rejected;
+					drop();		// Impossible length for id
+					break;
+				}
+				if ( resynced )
+					fstats.recovered += buflen;
+				if ( !complete(true) )
+					return x;
+			} else	{
+				++fstats.truncated;	// DLE <id>: lost DLE ETX
+				drop();
+				++fstats.resyncs;
+				start();		// Rescan id in fr_data
+				resynced = true;
+				++nstarts;
+			}
+			break;
+		}
+	}
+	return x;
+}
+
+//////////////////////////////////////////////////////////////////////
+// End a partially received packet (e.g. on timeout)
+//
+// RETURNS:
+//	true	- A packet was ended (ready, or passed to callback)
+//	false	- Not inside a packet
+//////////////////////////////////////////////////////////////////////
+
+bool
+TsipFramer::flush() {
+
+	if ( state == fr_idle )
+		return false;
+	if ( state == fr_start ) {
+		++fstats.dropped;		// Lone DLE
+		state = fr_idle;
+		return false;
+	}
+	complete(false);
+	return true;
+}
+
+// End framer.cpp
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////
+// framer.hpp -- TSIP Packet Framing (push parser)
+// Date: Sun Oct 18 10:02:17 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef FRAMER_HPP
+#define FRAMER_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef void (*framecb_t)(void *arg,uint8_t *packet,int length,bool ended);
+
+//////////////////////////////////////////////////////////////////////
+// Length rule: given the first length bytes of a packet, return 1
+// with the valid length range (maxlen 0 : no limit), 0 if any length
+// is valid, or -1 if more bytes are needed to tell (see tsiplen.hpp)
+//////////////////////////////////////////////////////////////////////
+
+typedef int (*lenrule_t)(const uint8_t *packet,int length,int& minlen,int& maxlen);
+
+//////////////////////////////////////////////////////////////////////
+// Framing error counters (since construction)
+//////////////////////////////////////////////////////////////////////
+
+struct s_framestats {
+	unsigned long	dropped;	// Bytes discarded (noise, broken frames)
+	unsigned long	rejected;	// Frames failing the length rule
+	unsigned long	truncated;	// Frames cut short by DLE <id>
+	unsigned long	overflows;	// Frames longer than the buffer
+	unsigned long	resyncs;	// Frames started at DLE <id> in a broken frame
+	unsigned long	recovered;	// Bytes of resynced frames delivered
+};
+
+//////////////////////////////////////////////////////////////////////
+// Frame a TSIP byte stream into packets:
+//
+//	DLE <id> <data, DLE stuffed> DLE ETX
+//
+// Bytes are pushed in with feed() in chunks of any size; the state
+// is kept across chunk boundaries. No I/O is performed here.
+//
+// With a callback registered, every completed packet is passed to
+// it and feed() consumes the whole chunk. Without one, feed() stops
+// just after a completed packet, which is then available from
+// packet()/length()/ended() until release() or the next feed().
+//
+// Broken input is resynchronized on the next DLE <id> (an id is any
+// byte but DLE and ETX). A DLE <id> inside a packet ends it as
+// truncated and starts the next packet there, rather than losing
+// both. With a length rule, a packet is rejected as soon as it grows
+// too long for its id (a lost DLE ETX), and at DLE ETX if too short.
+//////////////////////////////////////////////////////////////////////
+
+class TsipFramer {
+	enum e_state {
+		fr_idle,
+		fr_start,		// DLE seen, expecting the id
+		fr_data,
+		fr_escape
+	};
+
+	uint8_t	*buf;		// Packet buffer (caller's storage)
+	int	buflen;		// Current length of buffer
+	int	maxlen;		// Max length of buffer
+	e_state	state;		// Current framing state
+	bool	done;		// True when a packet is ready
+	bool	end_ok;		// True if ready packet ended with DLE ETX
+
+	framecb_t callback;	// Completed packet callback
+	void	*cbarg;		// Callback argument
+
+	lenrule_t rule;		// Length rule (or 0)
+	int	limit;		// Max length of this packet
+	int	minlen;		// Min length of this packet
+	int	ruled;		// rule() result for this packet (-1 : ask)
+	bool	resynced;	// Packet started inside a broken frame
+	unsigned long nstarts;	// Packet starts seen (leading DLEs)
+	s_framestats fstats;	// Error counters
+
+protected:
+	bool complete(bool ended);		// Deliver completed packet
+	void start();				// Begin a packet at its id
+	bool lookup();				// Apply rule: false if too long
+	void drop();				// Discard packet being framed
+
+public:	TsipFramer();
+
+	void open(uint8_t *buf,int maxlen);
+	inline void registercb(framecb_t cb,void *arg=0) { callback = cb; cbarg = arg; }
+	inline void setrule(lenrule_t rule) { this->rule = rule; }
+
+	size_t feed(const uint8_t *data,size_t len);
+	bool flush();				// End partial packet (timeout)
+	void reset();				// Discard partial packet
+	inline void release() { done = false; buflen = 0; } // Done with packet()
+
+	inline bool ready() const { return done; }
+	inline bool idle() const { return state == fr_idle; }
+	inline uint8_t *packet() { return buf; }
+	inline int length() const { return buflen; }
+	inline bool ended() const { return end_ok; }
+	inline unsigned long starts() const { return nstarts; } // Changes at each packet start
+	inline const s_framestats& stats() const { return fstats; }
+};
+
+#endif // FRAMER_HPP
+
+// End framer.hpp
@@ -0,0 +1,554 @@
+//////////////////////////////////////////////////////////////////////
+// layout.hpp -- Compile Time Wire Layouts of TSIP Reports
+// Date: Sun Oct 18 22:14:36 2026
+///////////////////////////////////////////////////////////////////////
+//
+// Each Layout<s_Rxx> names the report's fields as Field<type,offset>
+// types, offsets counted from the decoder's starting offset (after the
+// id, and sub id if any). Offsets chain from the previous field's end,
+// so the whole layout, and its fixed size, is worked out by the
+// compiler. A decoder checks the packet length once against size and
+// then loads every field at its constant offset:
+//
+//	typedef Layout<s_R41> L;
+//	const uint8_t *p = fixed(L::size);
+//
+//	if ( !p )
+//		return false;
+//	recd.time = L::time::load(p);
+//
+// Reports with a single/double time of fix (per state_sd) have both
+// time_of_fix1 and time_of_fix2 at one offset, and size and size_sd.
+//////////////////////////////////////////////////////////////////////
+
+#ifndef LAYOUT_HPP
+#define LAYOUT_HPP
+
+#include <stdint.h>
+#include <string.h>
+
+#include "tsip.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Big endian loads from unaligned bytes: memcpy plus a byte swap
+// builtin, which compile to a plain load and bswap (or movbe)
+//////////////////////////////////////////////////////////////////////
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BE_SWAP16(v)	(v)
+#define BE_SWAP32(v)	(v)
+#define BE_SWAP64(v)	(v)
+#else
+#define BE_SWAP16(v)	__builtin_bswap16(v)
+#define BE_SWAP32(v)	__builtin_bswap32(v)
+#define BE_SWAP64(v)	__builtin_bswap64(v)
+#endif
+
+static inline uint16_t
+be16(const uint8_t *p) {
+	uint16_t v;
+
+	memcpy(&v,p,sizeof v);
+	return BE_SWAP16(v);
+}
+
+static inline uint32_t
+be32(const uint8_t *p) {
+	uint32_t v;
+
+	memcpy(&v,p,sizeof v);
+	return BE_SWAP32(v);
+}
+
+static inline uint64_t
+be64(const uint8_t *p) {
+	uint64_t v;
+
+	memcpy(&v,p,sizeof v);
+	return BE_SWAP64(v);
+}
+
+static inline float
+bef(const uint8_t *p) {
+	uint32_t u = be32(p);
+	float f;
+
+	memcpy(&f,&u,sizeof f);
+	return f;
+}
+
+static inline double
+bed(const uint8_t *p) {
+	uint64_t u = be64(p);
+	double d;
+
+	memcpy(&d,&u,sizeof d);
+	return d;
+}
+
+template <typename T> inline T be_load(const uint8_t *p);
+
+template <> inline uint8_t be_load<uint8_t>(const uint8_t *p) { return *p; }
+template <> inline uint16_t be_load<uint16_t>(const uint8_t *p) { return be16(p); }
+template <> inline int16_t be_load<int16_t>(const uint8_t *p) { return int16_t(be16(p)); }
+template <> inline uint32_t be_load<uint32_t>(const uint8_t *p) { return be32(p); }
+template <> inline int32_t be_load<int32_t>(const uint8_t *p) { return int32_t(be32(p)); }
+template <> inline uint64_t be_load<uint64_t>(const uint8_t *p) { return be64(p); }
+template <> inline int64_t be_load<int64_t>(const uint8_t *p) { return int64_t(be64(p)); }
+template <> inline float be_load<float>(const uint8_t *p) { return bef(p); }
+template <> inline double be_load<double>(const uint8_t *p) { return bed(p); }
+
+//////////////////////////////////////////////////////////////////////
+// One field: type T at byte offset Off
+//////////////////////////////////////////////////////////////////////
+
+template <typename T,unsigned Off>
+struct Field {
+	typedef T type;
+	static constexpr unsigned offset = Off;
+	static constexpr unsigned width = sizeof(T);
+	static constexpr unsigned end = Off + sizeof(T);
+
+	static inline T load(const uint8_t *p) { return be_load<T>(p + Off); }
+};
+
+//////////////////////////////////////////////////////////////////////
+// N raw bytes at byte offset Off
+//////////////////////////////////////////////////////////////////////
+
+template <unsigned N,unsigned Off>
+struct Bytes {
+	static constexpr unsigned offset = Off;
+	static constexpr unsigned width = N;
+	static constexpr unsigned end = Off + N;
+
+	static inline void load(const uint8_t *p,uint8_t *to) { memcpy(to,p + Off,N); }
+};
+
+template <class R> struct Layout;	// Specialized per report
+
+//////////////////////////////////////////////////////////////////////
+// A layout's double precision size: size_sd if it has one, else size
+// (call with 0)
+//////////////////////////////////////////////////////////////////////
+
+template <class L>
+inline auto layout_size_sd(int) -> decltype(unsigned(L::size_sd)) { return L::size_sd; }
+
+template <class L>
+inline unsigned layout_size_sd(long) { return L::size; }
+
+//////////////////////////////////////////////////////////////////////
+// Fixed layout reports
+//////////////////////////////////////////////////////////////////////
+
+template <> struct Layout<s_R3D> {
+	typedef Field<uint8_t,0>			output_baud_rate;
+	typedef Field<uint8_t,output_baud_rate::end>	input_baud_rate;
+	typedef Field<uint8_t,input_baud_rate::end>	parity_bits;
+	typedef Field<uint8_t,parity_bits::end>		stop_flow;
+	typedef Field<uint8_t,stop_flow::end>		out_protocol;
+	typedef Field<uint8_t,out_protocol::end>	in_protocol;
+	static constexpr unsigned size = in_protocol::end;
+};
+
+template <> struct Layout<s_R40> {
+	typedef Field<uint8_t,0>			satellite;
+	typedef Field<float,satellite::end>		t_zc;
+	typedef Field<int16_t,t_zc::end>		week_no;
+	typedef Field<float,week_no::end>		eccentricity;
+	typedef Field<float,eccentricity::end>		t_oa;
+	typedef Field<float,t_oa::end>			i_o;
+	typedef Field<float,i_o::end>			omega_dot;
+	typedef Field<float,omega_dot::end>		sqrt_a;
+	typedef Field<float,sqrt_a::end>		omega_o;
+	typedef Field<float,omega_o::end>		omega;
+	typedef Field<float,omega::end>			m_o;
+	static constexpr unsigned size = m_o::end;
+};
+
+template <> struct Layout<s_R41> {
+	typedef Field<float,0>				time;
+	typedef Field<int16_t,time::end>		week;
+	typedef Field<float,week::end>			offset;
+	static constexpr unsigned size = offset::end;
+};
+
+template <> struct Layout<s_R42> {
+	typedef Field<float,0>				x;
+	typedef Field<float,x::end>			y;
+	typedef Field<float,y::end>			z;
+	typedef Field<float,z::end>			time_of_fix1;
+	typedef Field<double,z::end>			time_of_fix2;
+	static constexpr unsigned size = time_of_fix1::end;
+	static constexpr unsigned size_sd = time_of_fix2::end;
+};
+
+template <> struct Layout<s_R45> {
+	typedef Field<uint8_t,0>			major;
+	typedef Field<uint8_t,major::end>		minor;
+	typedef Field<uint8_t,minor::end>		month;
+	typedef Field<uint8_t,month::end>		day;
+	typedef Field<uint8_t,day::end>			year;
+	typedef Field<uint8_t,year::end>		major2;
+	typedef Field<uint8_t,major2::end>		minor2;
+	typedef Field<uint8_t,minor2::end>		month2;
+	typedef Field<uint8_t,month2::end>		day2;
+	typedef Field<uint8_t,day2::end>		year2;
+	static constexpr unsigned size = year2::end;
+};
+
+template <> struct Layout<s_R4C> {
+	typedef Field<uint8_t,0>			dynamics_code;
+	typedef Field<float,dynamics_code::end>		elevation_mask;
+	typedef Field<float,elevation_mask::end>	signal_level_mask;
+	typedef Field<float,signal_level_mask::end>	pdop_mask;
+	typedef Field<float,pdop_mask::end>		podp_switch;
+	static constexpr unsigned size = podp_switch::end;
+};
+
+template <> struct Layout<s_R4D> {
+	typedef Field<float,0>				offset;
+	static constexpr unsigned size = offset::end;
+};
+
+template <> struct Layout<s_R4E> {
+	typedef Field<uint8_t,0>			yn;
+	static constexpr unsigned size = yn::end;
+};
+
+template <> struct Layout<s_R4F> {
+	typedef Field<double,0>				a0;
+	typedef Field<float,a0::end>			a1;
+	typedef Field<int16_t,a1::end>			delta_t_ls;
+	typedef Field<float,delta_t_ls::end>		tot;
+	typedef Field<int16_t,tot::end>			wn_t;
+	typedef Field<int16_t,wn_t::end>		wn_lsf;
+	typedef Field<int16_t,wn_lsf::end>		dn;
+	typedef Field<int16_t,dn::end>			delta_t_lsf;
+	static constexpr unsigned size = delta_t_lsf::end;
+};
+
+template <> struct Layout<s_R54> {
+	typedef Field<float,0>				bias;
+	typedef Field<float,bias::end>			bias_rate;
+	typedef Field<float,bias_rate::end>		time_of_fix1;
+	typedef Field<double,bias_rate::end>		time_of_fix2;
+	static constexpr unsigned size = time_of_fix1::end;
+	static constexpr unsigned size_sd = time_of_fix2::end;
+};
+
+template <> struct Layout<s_R55> {
+	typedef Field<uint8_t,0>			position;
+	typedef Field<uint8_t,position::end>		velocity;
+	typedef Field<uint8_t,velocity::end>		timing;
+	typedef Field<uint8_t,timing::end>		auxiliary;
+	static constexpr unsigned size = auxiliary::end;
+};
+
+template <> struct Layout<s_R56> {
+	typedef Field<float,0>				eastvel;
+	typedef Field<float,eastvel::end>		northvel;
+	typedef Field<float,northvel::end>		upvel;
+	typedef Field<float,upvel::end>			clock_bias_rate;
+	typedef Field<float,clock_bias_rate::end>	time_of_fix1;
+	typedef Field<double,clock_bias_rate::end>	time_of_fix2;
+	static constexpr unsigned size = time_of_fix1::end;
+	static constexpr unsigned size_sd = time_of_fix2::end;
+};
+
+template <> struct Layout<s_R57> {
+	typedef Field<uint8_t,0>			info_src;
+	typedef Field<uint8_t,info_src::end>		track_mode;
+	typedef Field<float,track_mode::end>		fix_time;
+	typedef Field<int16_t,fix_time::end>		fix_week;
+	static constexpr unsigned size = fix_week::end;
+};
+
+template <> struct Layout<s_R5A> {
+	typedef Field<uint8_t,0>			sv_prn;
+	typedef Field<float,sv_prn::end>		samplength;
+	typedef Field<float,samplength::end>		siglevel;
+	typedef Field<float,siglevel::end>		code_phase;
+	typedef Field<float,code_phase::end>		doppler;
+	typedef Field<double,doppler::end>		time;
+	static constexpr unsigned size = time::end;
+};
+
+template <> struct Layout<s_R5C> {
+	typedef Field<uint8_t,0>			sv_prn;
+	typedef Field<uint8_t,sv_prn::end>		chan_slot;
+	typedef Field<uint8_t,chan_slot::end>		aquisflag;
+	typedef Field<uint8_t,aquisflag::end>		ephemflag;
+	typedef Field<float,ephemflag::end>		siglevel;
+	typedef Field<float,siglevel::end>		gps_time;
+	typedef Field<float,gps_time::end>		elevation;
+	typedef Field<float,elevation::end>		azimuth;
+	typedef Field<uint8_t,azimuth::end>		oldmeas;
+	typedef Field<uint8_t,oldmeas::end>		intmsec;
+	typedef Field<uint8_t,intmsec::end>		baddata;
+	typedef Field<uint8_t,baddata::end>		datacol;
+	static constexpr unsigned size = datacol::end;
+};
+
+template <> struct Layout<s_R5F11> {
+	typedef Field<int16_t,0>			status;
+	static constexpr unsigned size = status::end;
+};
+
+template <> struct Layout<s_R83> {
+	typedef Field<double,0>				x;
+	typedef Field<double,x::end>			y;
+	typedef Field<double,y::end>			z;
+	typedef Field<double,z::end>			clock_bias;
+	typedef Field<float,clock_bias::end>		time_of_fix1;
+	typedef Field<double,clock_bias::end>		time_of_fix2;
+	static constexpr unsigned size = time_of_fix1::end;
+	static constexpr unsigned size_sd = time_of_fix2::end;
+};
+
+template <> struct Layout<s_R84> {
+	typedef Field<double,0>				latitude;
+	typedef Field<double,latitude::end>		longitude;
+	typedef Field<double,longitude::end>		altitude;
+	typedef Field<double,altitude::end>		clock_bias;
+	typedef Field<float,clock_bias::end>		time_of_fix1;
+	typedef Field<double,clock_bias::end>		time_of_fix2;
+	static constexpr unsigned size = time_of_fix1::end;
+	static constexpr unsigned size_sd = time_of_fix2::end;
+};
+
+template <> struct Layout<s_R8F41> {
+	typedef Field<int16_t,0>			serprefix;
+	typedef Field<uint32_t,serprefix::end>		serialno;
+	typedef Field<uint8_t,serialno::end>		year;
+	typedef Field<uint8_t,year::end>		month;
+	typedef Field<uint8_t,month::end>		day;
+	typedef Field<uint8_t,day::end>			hour;
+	typedef Field<float,hour::end>			oscoffset;
+	typedef Field<int16_t,oscoffset::end>		testcode;
+	static constexpr unsigned size = testcode::end;
+};
+
+template <> struct Layout<s_R8F42> {
+	typedef Field<uint8_t,0>			optsprefix;
+	typedef Field<uint8_t,optsprefix::end>		pnextension;
+	typedef Field<int16_t,pnextension::end>		csnpref;
+	typedef Field<uint32_t,csnpref::end>		caseser;
+	typedef Field<uint32_t,caseser::end>		prodno;
+	typedef Field<int16_t,prodno::end>		reserved1;
+	typedef Field<int16_t,reserved1::end>		machid;
+	typedef Field<int16_t,machid::end>		reserved2;
+	static constexpr unsigned size = reserved2::end;
+};
+
+template <> struct Layout<s_R8FA5> {
+	typedef Field<uint16_t,0>			flags;
+	typedef Field<int16_t,flags::end>		mbz;
+	static constexpr unsigned size = mbz::end;
+};
+
+template <> struct Layout<s_R8FAB> {
+	typedef Field<uint64_t,0>			tow;
+	typedef Field<uint32_t,tow::end>		weekno;
+	typedef Field<int32_t,weekno::end>		utc_offset;
+	typedef Field<uint8_t,utc_offset::end>		timing_flags;
+	typedef Field<uint8_t,timing_flags::end>	seconds;
+	typedef Field<uint8_t,seconds::end>		minutes;
+	typedef Field<uint8_t,minutes::end>		hours;
+	typedef Field<uint8_t,hours::end>		mday;
+	typedef Field<uint8_t,mday::end>		month;
+	typedef Field<uint32_t,month::end>		year;
+	static constexpr unsigned size = year::end;
+};
+
+template <> struct Layout<s_RBB00> {
+	typedef Field<uint8_t,0>			opdim;
+	typedef Field<uint8_t,opdim::end>		dgps_mode;
+	typedef Field<uint8_t,dgps_mode::end>		dyn_mode;
+	typedef Field<uint8_t,dyn_mode::end>		sol_mode;
+	typedef Field<float,sol_mode::end>		elev_mask;
+	typedef Field<float,elev_mask::end>		amu_mask;
+	typedef Field<float,amu_mask::end>		pdop_mask;
+	typedef Field<float,pdop_mask::end>		pdop_switch;
+	typedef Field<uint8_t,pdop_switch::end>		dgps_age;
+	typedef Field<uint8_t,dgps_age::end>		foliage_mode;
+	typedef Field<uint8_t,foliage_mode::end>	reserved1;
+	typedef Field<uint8_t,reserved1::end>		reserved2;
+	typedef Field<uint8_t,reserved2::end>		meas_rate;
+	typedef Field<uint8_t,meas_rate::end>		posfx_rate;
+	static constexpr unsigned size = posfx_rate::end;
+};
+
+//////////////////////////////////////////////////////////////////////
+// Reports with a fixed head (size) and a shorter required part (min)
+// or a variable tail
+//////////////////////////////////////////////////////////////////////
+
+template <> struct Layout<s_R43> {
+	typedef Field<float,0>				x_velocity;
+	typedef Field<float,x_velocity::end>		y_velocity;
+	typedef Field<float,y_velocity::end>		z_velocity;
+	typedef Field<float,z_velocity::end>		bias_rate;
+	typedef Field<float,bias_rate::end>		time_of_fix1;
+	typedef Field<double,bias_rate::end>		time_of_fix2;
+	static constexpr unsigned min = y_velocity::end;
+	static constexpr unsigned size = time_of_fix1::end;
+	static constexpr unsigned size_sd = time_of_fix2::end;
+};
+
+template <> struct Layout<s_R4A> {
+	typedef Field<float,0>				latitude;
+	typedef Field<float,latitude::end>		longitude;
+	typedef Field<float,longitude::end>		altitude;
+	typedef Field<float,altitude::end>		clock_bias;
+	typedef Field<float,clock_bias::end>		time_of_fix1;
+	typedef Field<double,clock_bias::end>		time_of_fix2;
+	static constexpr unsigned min = longitude::end;
+	static constexpr unsigned size = time_of_fix1::end;
+	static constexpr unsigned size_sd = time_of_fix2::end;
+};
+
+template <> struct Layout<s_R5B> {
+	typedef Field<uint8_t,0>			sv_prn;
+	typedef Field<float,sv_prn::end>		coltime;
+	typedef Field<uint8_t,coltime::end>		health;
+	typedef Field<uint8_t,health::end>		iode;
+	typedef Field<float,iode::end>			t_oe;
+	typedef Field<uint8_t,t_oe::end>		fit_ival_flag;
+	typedef Field<float,fit_ival_flag::end>		ura;
+	static constexpr unsigned min = iode::end;
+	static constexpr unsigned size = ura::end;
+};
+
+template <> struct Layout<s_R6D> {
+	typedef Field<uint8_t,0>			fixmode;
+	typedef Field<float,fixmode::end>		pdop;
+	typedef Field<float,pdop::end>			hdop;
+	typedef Field<float,hdop::end>			vdop;
+	typedef Field<float,vdop::end>			tdop;
+	static constexpr unsigned size = tdop::end;	// sv_prn[] follows
+};
+
+template <> struct Layout<s_R1C81> {
+	typedef Field<uint8_t,0>			reserved1;
+	typedef Field<uint8_t,reserved1::end>		major_firm;
+	typedef Field<uint8_t,major_firm::end>		minor_firm;
+	typedef Field<uint8_t,minor_firm::end>		build_no;
+	typedef Field<uint8_t,build_no::end>		month;
+	typedef Field<uint8_t,month::end>		day;
+	typedef Field<int16_t,day::end>			year;
+	typedef Field<uint8_t,year::end>		length;
+	static constexpr unsigned size = length::end;	// prodname follows
+};
+
+template <> struct Layout<s_R1C83> {
+	typedef Field<uint32_t,0>			serialno;
+	typedef Field<uint8_t,serialno::end>		day;
+	typedef Field<uint8_t,day::end>			month;
+	typedef Field<uint16_t,month::end>		year;
+	typedef Field<uint8_t,year::end>		hour;
+	typedef Field<uint8_t,hour::end>		hardw_code;
+	typedef Field<uint8_t,hardw_code::end>		length;
+	static constexpr unsigned size = length::end;	// hardw_id follows
+};
+
+//////////////////////////////////////////////////////////////////////
+// Variable layout reports: per record layouts, repeated
+//////////////////////////////////////////////////////////////////////
+
+template <> struct Layout<s_R47> {
+	typedef Field<uint8_t,0>			count;
+	static constexpr unsigned size = count::end;	// count sats follow
+
+	struct sat {
+		typedef Field<uint8_t,0>		prn;
+		typedef Field<float,prn::end>		siglevel;
+		static constexpr unsigned size = siglevel::end;
+	};
+};
+
+template <> struct Layout<s_R58> {
+	typedef Field<uint8_t,0>			operation;
+	typedef Field<uint8_t,operation::end>		datatype;
+	typedef Field<uint8_t,datatype::end>		sv_prn;
+	typedef Field<uint8_t,sv_prn::end>		n;
+	static constexpr unsigned size = n::end;	// n records follow
+};
+
+template <> struct Layout<s_R58::s_almanac> {
+	typedef Field<uint8_t,0>			t_oa_raw;
+	typedef Field<uint8_t,t_oa_raw::end>		sv_health;
+	typedef Field<float,sv_health::end>		e;	// 15 floats,
+	typedef Field<float,e::end + 13 * 4>		t_zc;	// e to t_zc
+	typedef Field<int16_t,t_zc::end>		weeknum;
+	typedef Field<int16_t,weeknum::end>		wn_oa;
+	static constexpr unsigned size = wn_oa::end;
+};
+
+template <> struct Layout<s_R58::s_health> {
+	typedef Field<uint8_t,0>			weekno;
+	typedef Bytes<32,weekno::end>			sv_health;
+	typedef Field<uint8_t,sv_health::end>		t_oa;
+	typedef Field<uint8_t,t_oa::end>		cur_t_oa;
+	typedef Field<int16_t,cur_t_oa::end>		cur_weekno;
+	static constexpr unsigned size = cur_weekno::end;
+};
+
+template <> struct Layout<s_R58::s_ionosphere> {
+	typedef Bytes<8,0>				compressed;
+	typedef Field<float,compressed::end>		alpha_0;	// 8 floats,
+	typedef Field<float,alpha_0::end + 6 * 4>	beta_3;		// to beta_3
+	static constexpr unsigned size = beta_3::end;
+};
+
+template <> struct Layout<s_R58::s_utc> {
+	typedef Bytes<13,0>				compressed;
+	typedef Field<double,compressed::end>		a_0;
+	typedef Field<float,a_0::end>			a_1;
+	typedef Field<int16_t,a_1::end>			delta_t_ls;
+	typedef Field<float,delta_t_ls::end>		t_ot;
+	typedef Field<int16_t,t_ot::end>		wn_t;
+	typedef Field<int16_t,wn_t::end>		wn_lsf;
+	typedef Field<int16_t,wn_lsf::end>		dn;
+	typedef Field<int16_t,dn::end>			delta_t_lsf;
+	static constexpr unsigned size = delta_t_lsf::end;
+};
+
+template <> struct Layout<s_R58::s_ephemeris> {
+	typedef Field<uint8_t,0>			sv_prn;
+	typedef Field<float,sv_prn::end>		t_ephem;
+	typedef Field<int16_t,t_ephem::end>		weekno;
+	typedef Field<uint8_t,weekno::end>		codel2;
+	typedef Field<uint8_t,codel2::end>		l2pdata;
+	typedef Field<uint8_t,l2pdata::end>		svacc_raw;
+	typedef Field<uint8_t,svacc_raw::end>		sv_health;
+	typedef Field<int16_t,sv_health::end>		iodc;
+	typedef Field<float,iodc::end>			t_gd;	// 6 floats,
+	typedef Field<float,t_gd::end + 4 * 4>		svacc;	// t_gd to svacc
+	typedef Field<uint8_t,svacc::end>		iode;
+	typedef Field<uint8_t,iode::end>		fit_ival;
+	typedef Field<float,fit_ival::end>		c_rs;
+	typedef Field<float,c_rs::end>			delta_n;
+	typedef Field<double,delta_n::end>		m_0;
+	typedef Field<float,m_0::end>			c_uc;
+	typedef Field<double,c_uc::end>			e;
+	typedef Field<float,e::end>			c_us;
+	typedef Field<double,c_us::end>			sqrt_a;
+	typedef Field<float,sqrt_a::end>		t_oe;
+	typedef Field<float,t_oe::end>			c_ic;
+	typedef Field<double,c_ic::end>			omega_0;
+	typedef Field<float,omega_0::end>		c_is;
+	typedef Field<double,c_is::end>			i_o;
+	typedef Field<float,i_o::end>			c_rc;
+	typedef Field<double,c_rc::end>			omega;
+	typedef Field<float,omega::end>			omegadot;
+	typedef Field<float,omegadot::end>		idot;
+	typedef Field<double,idot::end>			axis;	// 5 doubles,
+	typedef Field<double,axis::end + 3 * 8>		odot_n;	// axis to odot_n
+	static constexpr unsigned size = odot_n::end;
+};
+
+#endif // LAYOUT_HPP
+
+// End layout.hpp
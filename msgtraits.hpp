@@ -0,0 +1,158 @@
+//////////////////////////////////////////////////////////////////////
+// msgtraits.hpp -- Compile Time Report Registry and Variant Decoding
+// Date: Sun Oct 18 23:48:12 2026
+///////////////////////////////////////////////////////////////////////
+//
+// TSIP_REPORTS lists every report with a decoder, as X(full id,record):
+// the hand written ones here, then TSIP_GENERATED(X) from rgen's
+// rlist.h for the rest. From that one list come:
+//
+//	MsgTraits<0x84>::type	- s_R84
+//	MsgId<s_R84>::id	- 0x84
+//	MsgId<s_R84>::name	- "s_R84"
+//	RxReport		- std::variant of every record, plus
+//				  s_RxUnknown and s_RxError
+//	decode(rxpkt)		- id() and the matching get()
+//
+// so adding a hand written report takes one line here, and a report
+// added to msgs.dat none. Callers std::visit() the result. A visitor
+// missing an overload for any record fails to compile, so a new
+// report can't fall through unnoticed (a generic overload is how a
+// caller chooses to handle generated reports alike):
+//
+//	std::visit([&](const auto& r) { show(r); },decode(rxpkt));
+//////////////////////////////////////////////////////////////////////
+
+#ifndef MSGTRAITS_HPP
+#define MSGTRAITS_HPP
+
+#include <stdint.h>
+#include <variant>
+
+#include "tsip.hpp"
+#include "rlist.h"
+
+#define TSIP_REPORTS(X)		\
+	X(0x1C81,s_R1C81)	\
+	X(0x1C83,s_R1C83)	\
+	X(0x3D,s_R3D)		\
+	X(0x40,s_R40)		\
+	X(0x41,s_R41)		\
+	X(0x42,s_R42)		\
+	X(0x43,s_R43)		\
+	X(0x45,s_R45)		\
+	X(0x46,s_R46)		\
+	X(0x47,s_R47)		\
+	X(0x48,s_R48)		\
+	X(0x49,s_R49)		\
+	X(0x4A,s_R4A)		\
+	X(0x4B,s_R4B)		\
+	X(0x4C,s_R4C)		\
+	X(0x4D,s_R4D)		\
+	X(0x4E,s_R4E)		\
+	X(0x4F,s_R4F)		\
+	X(0x54,s_R54)		\
+	X(0x55,s_R55)		\
+	X(0x56,s_R56)		\
+	X(0x57,s_R57)		\
+	X(0x58,s_R58)		\
+	X(0x59,s_R59)		\
+	X(0x5A,s_R5A)		\
+	X(0x5B,s_R5B)		\
+	X(0x5C,s_R5C)		\
+	X(0x5F11,s_R5F11)	\
+	X(0x6D,s_R6D)		\
+	X(0x82,s_R82)		\
+	X(0x83,s_R83)		\
+	X(0x84,s_R84)		\
+	X(0x8F41,s_R8F41)	\
+	X(0x8F42,s_R8F42)	\
+	X(0x8FA5,s_R8FA5)	\
+	X(0x8FAB,s_R8FAB)	\
+	X(0xBB00,s_RBB00)	\
+	TSIP_GENERATED(X)
+
+//////////////////////////////////////////////////////////////////////
+// decode() results other than a record
+//////////////////////////////////////////////////////////////////////
+
+struct s_RxUnknown {
+	uint16_t	id;		// Not in TSIP_REPORTS (0x10: empty packet)
+};
+
+struct s_RxError {
+	uint16_t	id;		// Report id
+	uint16_t	offset;		// Where get() ran out of packet
+};
+
+//////////////////////////////////////////////////////////////////////
+// Id <-> record, for registered reports only
+//////////////////////////////////////////////////////////////////////
+
+template <uint16_t Id> struct MsgTraits;
+template <class R> struct MsgId;
+
+#define TSIP_TRAITS(id_,rec)						\
+	template <> struct MsgTraits<id_> {				\
+		typedef rec type;					\
+		static constexpr uint16_t id = id_;			\
+	};								\
+	template <> struct MsgId<rec> {					\
+		static constexpr uint16_t id = id_;			\
+		static constexpr const char *name = #rec;		\
+	};
+
+TSIP_REPORTS(TSIP_TRAITS)
+
+#undef TSIP_TRAITS
+
+#define TSIP_ALTERNATIVE(id_,rec)	,rec
+
+typedef std::variant<s_RxUnknown,s_RxError TSIP_REPORTS(TSIP_ALTERNATIVE)> RxReport;
+
+#undef TSIP_ALTERNATIVE
+
+//////////////////////////////////////////////////////////////////////
+// Decode as the record registered under key, in place in rpt
+//
+// RETURNS:
+//	false if no record is registered under key
+//////////////////////////////////////////////////////////////////////
+
+inline bool
+decode_as(RxPacket& rxpkt,uint16_t key,uint16_t id,RxReport& rpt) {
+
+	switch ( key ) {
+#define TSIP_DECODE(id_,rec)						\
+	case id_ :							\
+		if ( !rxpkt.get(rpt.emplace<rec>()) )			\
+			rpt = s_RxError{id,rxpkt.get_offset()};		\
+		return true;
+
+	TSIP_REPORTS(TSIP_DECODE)
+
+#undef TSIP_DECODE
+	default :
+		return false;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Decode the report in rxpkt (just loaded). A plain report under an
+// id that also has sub ids (5F beside 5F 11) comes back from id()
+// with the next byte as a sub id; its decoder allows for that.
+//////////////////////////////////////////////////////////////////////
+
+inline RxReport
+decode(RxPacket& rxpkt) {
+	uint16_t id = rxpkt.id();
+	RxReport rpt(s_RxUnknown{id});
+
+	if ( !decode_as(rxpkt,id,id,rpt) && id > 0xFF )
+		decode_as(rxpkt,id >> 8,id,rpt);
+	return rpt;
+}
+
+#endif // MSGTRAITS_HPP
+
+// End msgtraits.hpp
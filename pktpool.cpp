@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////
+// pktpool.cpp -- Fixed Size Packet Buffer Pool
+// Date: Sun Oct 18 11:24:09 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <assert.h>
+
+#include "pktpool.hpp"
+
+PacketPool::PacketPool() : cursor(0), fails(0) {
+	slab = 0;
+	busy = 0;
+	nbufs = 0;
+	bufsize = 0;
+}
+
+PacketPool::~PacketPool() {
+	delete[] slab;
+	delete[] busy;
+}
+
+void
+PacketPool::open(int nbufs,int bufsize) {
+
+	assert(!slab);
+	if ( nbufs <= 0 )
+		nbufs = 16;
+	if ( bufsize <= 0 )
+		bufsize = 1024;
+
+	this->nbufs = nbufs;
+	this->bufsize = bufsize;
+	slab = new uint8_t[nbufs * bufsize];
+	busy = new std::atomic<bool>[nbufs];
+	for ( int x=0; x<nbufs; ++x )
+		busy[x].store(false);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Claim a free buffer
+//
+// RETURNS:
+//	Buffer of size() bytes, or 0 if all are in use
+//////////////////////////////////////////////////////////////////////
+
+uint8_t *
+PacketPool::alloc() {
+	unsigned start = cursor.load(std::memory_order_relaxed);
+
+	for ( int x=0; x<nbufs; ++x ) {
+		unsigned ix = (start + x) % nbufs;
+		bool expect = false;
+
+		if ( busy[ix].compare_exchange_strong(expect,true,std::memory_order_acquire) ) {
+			cursor.store(ix+1,std::memory_order_relaxed);
+			return slab + ix * bufsize;
+		}
+	}
+	fails.fetch_add(1,std::memory_order_relaxed);
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Return a buffer obtained from alloc()
+//////////////////////////////////////////////////////////////////////
+
+void
+PacketPool::free(uint8_t *buf) {
+	int ix = (buf - slab) / bufsize;
+
+	assert(buf >= slab && ix < nbufs);
+	assert(busy[ix].load());
+	busy[ix].store(false,std::memory_order_release);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Packet handle
+//////////////////////////////////////////////////////////////////////
+
+PooledPacket::PooledPacket(PooledPacket&& other) {
+	pool = other.pool;
+	buf = other.buf;
+	length = other.length;
+	ended = other.ended;
+	tstamp = other.tstamp;
+	other.pool = 0;
+	other.buf = 0;
+	other.length = 0;
+}
+
+PooledPacket&
+PooledPacket::operator=(PooledPacket&& other) {
+
+	if ( this != &other ) {
+		release();
+		pool = other.pool;
+		buf = other.buf;
+		length = other.length;
+		ended = other.ended;
+		tstamp = other.tstamp;
+		other.pool = 0;
+		other.buf = 0;
+		other.length = 0;
+	}
+	return *this;
+}
+
+void
+PooledPacket::assign(PacketPool *pool,uint8_t *buf,int length,bool ended) {
+	release();
+	this->pool = pool;
+	this->buf = buf;
+	this->length = length;
+	this->ended = ended;
+}
+
+void
+PooledPacket::release() {
+	if ( buf && pool )
+		pool->free(buf);
+	pool = 0;
+	buf = 0;
+	length = 0;
+	ended = false;
+}
+
+// End pktpool.cpp
@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////
+// pktpool.hpp -- Fixed Size Packet Buffer Pool
+// Date: Sun Oct 18 11:20:36 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef PKTPOOL_HPP
+#define PKTPOOL_HPP
+
+#include <stdint.h>
+#include <atomic>
+
+class PooledPacket;
+
+//////////////////////////////////////////////////////////////////////
+// Arrival times of a received packet, in ns. Each is taken right
+// after the read() that returned the byte:
+//
+//	start	- the leading DLE
+//	end	- the DLE ETX (last byte, if the packet timed out)
+//////////////////////////////////////////////////////////////////////
+
+struct s_pktstamp {
+	uint64_t	mono_start;	// CLOCK_MONOTONIC
+	uint64_t	mono_end;
+	uint64_t	real_start;	// CLOCK_REALTIME
+	uint64_t	real_end;
+};
+
+//////////////////////////////////////////////////////////////////////
+// A slab of nbufs packet buffers of bufsize bytes each, allocated
+// once by open(). alloc() and free() do no heap allocation and may
+// be called from different threads (free() from any thread).
+//////////////////////////////////////////////////////////////////////
+
+class PacketPool {
+	uint8_t	*slab;		// nbufs * bufsize bytes
+	std::atomic<bool> *busy; // Per buffer: true when allocated
+	std::atomic<unsigned> cursor; // Where to start looking in alloc()
+	int	nbufs;		// Number of buffers
+	int	bufsize;	// Size of each buffer
+	std::atomic<unsigned long> fails; // alloc() found no free buffer
+
+public:	PacketPool();
+	~PacketPool();
+
+	void open(int nbufs=16,int bufsize=1024);
+
+	uint8_t *alloc();			// Returns 0 when exhausted
+	void free(uint8_t *buf);
+
+	inline int size() const { return bufsize; }
+	inline int count() const { return nbufs; }
+	inline unsigned long failures() const { return fails; }
+};
+
+//////////////////////////////////////////////////////////////////////
+// Move-only handle owning one pool buffer holding a received packet.
+// The buffer goes back to its pool when the handle is released or
+// destroyed.
+//////////////////////////////////////////////////////////////////////
+
+class PooledPacket {
+	PacketPool *pool;	// Owning pool (0 if empty)
+	uint8_t	*buf;		// Packet bytes
+	int	length;		// Packet length
+	bool	ended;		// True if ended by DLE ETX
+	s_pktstamp tstamp;	// Arrival times
+
+public:	PooledPacket() : pool(0), buf(0), length(0), ended(false), tstamp() {}
+	PooledPacket(PooledPacket&& other);
+	~PooledPacket() { release(); }
+
+	PooledPacket& operator=(PooledPacket&& other);
+	PooledPacket(const PooledPacket&) = delete;
+	PooledPacket& operator=(const PooledPacket&) = delete;
+
+	void assign(PacketPool *pool,uint8_t *buf,int length,bool ended);
+	void release();
+
+	inline uint8_t *data() { return buf; }
+	inline int size() const { return length; }
+	inline bool is_ended() const { return ended; }
+	inline bool empty() const { return !buf; }
+	inline const s_pktstamp& stamp() const { return tstamp; }
+	inline void set_stamp(const s_pktstamp& stamp) { tstamp = stamp; }
+};
+
+#endif // PKTPOOL_HPP
+
+// End pktpool.hpp
@@ -0,0 +1,1224 @@
+//////////////////////////////////////////////////////////////////////
+// rcheck.cpp -- Self Checks over Socket Pairs (make check)
+// Date: Mon Oct 19 01:12:40 2026
+///////////////////////////////////////////////////////////////////////
+//
+// Each check drives the real classes through a socketpair standing
+// in for the receiver, and prints one line. The exit status is the
+// number of checks that failed.
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <pthread.h>
+#include <math.h>
+#include <float.h>
+
+#include <vector>
+
+#include "ttyio.hpp"
+#include "tsip.hpp"
+#include "reactor.hpp"
+#include "uring.hpp"
+#include "layout.hpp"
+#include "rxthread.hpp"
+#include "rptdisp.hpp"
+#include "rxview.hpp"
+#include "msgtraits.hpp"
+#include "rptbatch.hpp"
+#include "beswap.hpp"
+#include "fixpt.hpp"
+
+static int failures = 0;
+
+//////////////////////////////////////////////////////////////////////
+// Report one check
+//////////////////////////////////////////////////////////////////////
+
+static bool
+check(const char *what,bool ok,const char *detail="") {
+
+	printf("%-28s %s%s%s\n",what,ok ? "ok" : "FAILED",*detail ? "  " : "",detail);
+	if ( !ok )
+		++failures;
+	return ok;
+}
+
+//////////////////////////////////////////////////////////////////////
+// A 0x41 report, as the receiver would send it
+//////////////////////////////////////////////////////////////////////
+
+static void
+make_r41(TxPacket& tx,uint8_t *buf,uint16_t size,float tow) {
+
+	tx.open(buf,size);
+	tx.command(0x41);
+	tx.put(tow);
+	tx.put(int16_t(2100));
+	tx.put(float(18.0));
+	tx.close();
+}
+
+// Drain what is waiting on the non-blocking end fd
+static void
+drain(int fd,std::vector<uint8_t>& into) {
+	uint8_t buf[4096];
+	ssize_t rc;
+
+	while ( (rc = read(fd,buf,sizeof buf)) > 0 )
+		into.insert(into.end(),buf,buf + rc);
+}
+
+//////////////////////////////////////////////////////////////////////
+// UringReactor: reports in, command frames out through a small send
+// buffer (forcing writes to wait, or come up short), and a reply put()
+// from inside the handler, i.e. while completions are being reaped
+//////////////////////////////////////////////////////////////////////
+
+static const int ucmds = 48;
+
+struct s_uring_check {
+	UringReactor	*ur;
+	TxPacket	reply;
+	uint8_t		reply_buf[32];
+	int		packets;
+	int		replies;
+};
+
+static void
+uring_rx(Packet&,RxPacket& rxpkt,bool ended,void *arg) {
+	s_uring_check& uc = *(s_uring_check *)arg;
+	TxPacket *frames[1] = { &uc.reply };
+
+	if ( ended && rxpkt.id() == 0x41 )
+		++uc.packets;
+	if ( uc.ur->put(0,frames,1) )
+		++uc.replies;
+}
+
+static void
+check_uring() {
+	UringReactor ur;
+	Packet pkt;
+	s_uring_check uc;
+	TxPacket cmds[ucmds], rpt;
+	TxPacket *frames[ucmds];
+	uint8_t cbuf[ucmds][300], rbuf[32];
+	std::vector<uint8_t> want, got;
+	int sv[2], sndbuf = 2048, x;
+	char detail[96];
+
+	if ( !ur.open(4) ) {
+		check("uring smoke",true,"skipped: no io_uring");
+		return;
+	}
+
+	if ( socketpair(AF_UNIX,SOCK_STREAM,0,sv) < 0 ) {
+		check("uring smoke",false,strerror(errno));
+		return;
+	}
+	setsockopt(sv[0],SOL_SOCKET,SO_SNDBUF,&sndbuf,sizeof sndbuf);
+	fcntl(sv[1],F_SETFL,fcntl(sv[1],F_GETFL) | O_NONBLOCK);
+
+	pkt.open(0,1024,sv[0]);
+	uc.ur = &ur;
+	uc.packets = uc.replies = 0;
+	uc.reply.open(uc.reply_buf,sizeof uc.reply_buf);
+	uc.reply.command(0x21);
+	uc.reply.close();
+
+	check("uring add",ur.add(pkt,uring_rx,&uc) == 0);
+
+	// Command frames, DLE stuffed payloads of varying length
+	for ( x=0; x<ucmds; ++x ) {
+		cmds[x].open(cbuf[x],sizeof cbuf[x]);
+		cmds[x].command(0x8E);
+		for ( int y=0; y<100 + x; ++y )
+			cmds[x].put(uint8_t(y % 3 == 0 ? 0x10 : x + y));
+		cmds[x].close();
+		frames[x] = &cmds[x];
+		want.insert(want.end(),cmds[x].data(),cmds[x].data() + cmds[x].size());
+	}
+	check("uring put",ur.put(0,frames,ucmds));
+
+	// Three reports from the "receiver"
+	for ( x=0; x<3; ++x ) {
+		make_r41(rpt,rbuf,sizeof rbuf,float(x));
+		if ( ::write(sv[1],rpt.data(),rpt.size()) != rpt.size() )
+			break;
+		want.insert(want.end(),uc.reply.data(),uc.reply.data() + uc.reply.size());
+	}
+
+	for ( x=0; x<400 && (uc.packets < 3 || ur.writes(0) > 0); ++x ) {
+		if ( ur.run_once(5) < 0 )
+			break;
+		drain(sv[1],got);
+	}
+	drain(sv[1],got);
+
+	snprintf(detail,sizeof detail,"%d rounds, %lu short writes, %lu syscalls",
+		x,ur.short_writes(),ur.syscalls());
+	check("uring reports",uc.packets == 3 && ur.packets() == 3);
+	check("uring writes in order",uc.replies == 3 && got == want
+		&& ur.write_errors() == 0,detail);
+
+	shutdown(sv[1],SHUT_WR);		// EOF
+	for ( x=0; x<100 && ur.active() > 0; ++x )
+		ur.run_once(5);
+	check("uring EOF",ur.active() == 0 && ur.run_once(0) == -1);
+	close(sv[1]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Length rules: the shortest reports the decoders take (43, 4A, 5B at
+// Layout<>::min bytes, 46 and 4B with only their first byte) and a 47
+// from a receiver tracking 13 satellites must get through the framer,
+// not be rejected
+//////////////////////////////////////////////////////////////////////
+
+static void
+check_short_reports() {
+	static const struct {
+		uint8_t	id;
+		int	bytes;			// After the id
+	} rpts[] = {
+		{ 0x43, int(Layout<s_R43>::min) },
+		{ 0x4A, int(Layout<s_R4A>::min) },
+		{ 0x5B, int(Layout<s_R5B>::min) },
+		{ 0x4A, int(Layout<s_R4A>::size) },
+		{ 0x46, 1 },
+		{ 0x4B, 1 },
+		{ 0x47, 1 + 13 * int(Layout<s_R47>::sat::size) }
+	};
+	const int nrpts = sizeof rpts / sizeof rpts[0];
+	Packet pkt;
+	RxPacket rxpkt;
+	TxPacket tx;
+	uint8_t buf[160], *packet;
+	int sv[2], length, decoded = 0;
+	bool ended, ok;
+
+	if ( socketpair(AF_UNIX,SOCK_STREAM,0,sv) < 0 ) {
+		check("short reports",false,strerror(errno));
+		return;
+	}
+
+	for ( int x=0; x<nrpts; ++x ) {
+		tx.open(buf,sizeof buf);
+		tx.command(rpts[x].id);
+		for ( int y=0; y<rpts[x].bytes; ++y )	// 47: count of 13
+			tx.put(uint8_t(y == 0 && rpts[x].id == 0x47 ? 13 : 0x40 + y));
+		tx.close();
+		if ( ::write(sv[1],tx.data(),tx.size()) != tx.size() )
+			break;
+	}
+	close(sv[1]);
+
+	pkt.open(0,1024,sv[0]);		// Length rules on by default
+	for (;;) {
+		pkt.get(&packet,&length,ended);
+		if ( length <= 0 )
+			break;
+		rxpkt.load(packet,length);
+		switch ( rxpkt.id() ) {
+		case 0x43 :
+			{
+				s_R43 r;
+				ok = rxpkt.get(r);
+			}
+			break;
+		case 0x4A :
+			{
+				s_R4A r;
+				ok = rxpkt.get(r);
+			}
+			break;
+		case 0x5B :
+			{
+				s_R5B r;
+				ok = rxpkt.get(r);
+			}
+			break;
+		case 0x46 :
+			{
+				s_R46 r;
+				ok = rxpkt.get(r) && r.u.error_code == 0;
+			}
+			break;
+		case 0x4B :
+			{
+				s_R4B r;
+				ok = rxpkt.get(r) && r.machine_id == 0x40 && r.status2 == 0;
+			}
+			break;
+		case 0x47 :
+			{
+				s_R47 r;
+				ok = rxpkt.get(r) && r.sat[11].prn == 0x40 + 1 + 11 * 5;
+			}
+			break;
+		default :
+			ok = false;
+		}
+		decoded += ok;
+	}
+	check("short reports pass rules",decoded == nrpts
+		&& pkt.framing().rejected == 0);
+}
+
+//////////////////////////////////////////////////////////////////////
+// PacketPool: a packet framed into Packet's own buffer while the
+// pool was exhausted, and longer than a pool buffer, must be dropped
+// rather than copied past the end of one. The only buffer is freed
+// by another thread while get() waits, so the copy finds it free.
+//////////////////////////////////////////////////////////////////////
+
+struct s_pool_check {
+	PooledPacket	held;		// The pool's only buffer
+	int		fd;		// Receiver's end
+};
+
+static void *
+pool_sender(void *arg) {
+	s_pool_check& pc = *(s_pool_check *)arg;
+	TxPacket tx;
+	uint8_t buf[256];
+
+	usleep(20000);			// Let get() start waiting
+	pc.held.release();
+	tx.open(buf,sizeof buf);	// Longer than a pool buffer
+	tx.command(0x13);
+	for ( int y=0; y<100; ++y )
+		tx.put(uint8_t(y));
+	tx.close();
+	if ( ::write(pc.fd,tx.data(),tx.size()) == tx.size() ) {
+		make_r41(tx,buf,sizeof buf,2.0f);
+		(void)!::write(pc.fd,tx.data(),tx.size());
+	}
+	close(pc.fd);
+	return 0;
+}
+
+static void
+check_pool_copy() {
+	PacketPool pool;
+	PooledPacket second;
+	s_pool_check pc;
+	Packet pkt;
+	TxPacket tx;
+	pthread_t tid;
+	uint8_t buf[64];
+	int sv[2];
+	bool ok;
+
+	if ( socketpair(AF_UNIX,SOCK_STREAM,0,sv) < 0 ) {
+		check("pool copy",false,strerror(errno));
+		return;
+	}
+
+	make_r41(tx,buf,sizeof buf,1.0f);
+	ok = ::write(sv[1],tx.data(),tx.size()) == tx.size();
+
+	pool.open(1,32);
+	pkt.open(0,1024,sv[0]);
+	pkt.setpool(&pool);
+	ok = ok && pkt.get(pc.held);		// Pool now exhausted
+
+	pc.fd = sv[1];
+	pthread_create(&tid,0,pool_sender,&pc);
+	ok = ok && pkt.get(second) && second.data()[0] == 0x41;
+	pthread_join(tid,0);
+
+	check("pool drops oversized copy",ok && pkt.stats().pool_drops == 1);
+	second.release();
+	pkt.setpool(0);
+}
+
+// Framed straight into a pool buffer, a packet too long for it is
+// the framer's to drop (an overflow), not a pool drop
+static void
+check_pool_slab() {
+	PacketPool pool;
+	PooledPacket got;
+	Packet pkt;
+	TxPacket tx;
+	uint8_t buf[256];
+	int sv[2];
+	bool ok;
+
+	if ( socketpair(AF_UNIX,SOCK_STREAM,0,sv) < 0 ) {
+		check("pool slab overflow",false,strerror(errno));
+		return;
+	}
+
+	tx.open(buf,sizeof buf);		// Longer than a pool buffer
+	tx.command(0x13);
+	for ( int y=0; y<100; ++y )
+		tx.put(uint8_t(y));
+	tx.close();
+	ok = ::write(sv[1],tx.data(),tx.size()) == tx.size();
+	make_r41(tx,buf,sizeof buf,1.0f);
+	ok = ok && ::write(sv[1],tx.data(),tx.size()) == tx.size();
+	close(sv[1]);
+
+	pool.open(2,32);
+	pkt.open(0,1024,sv[0]);
+	pkt.setpool(&pool);
+	ok = ok && pkt.get(got) && got.data()[0] == 0x41;
+
+	check("pool slab overflow",ok && pkt.framing().overflows == 1
+		&& pkt.stats().pool_drops == 0);
+	got.release();
+	pkt.setpool(0);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Arrival stamps: a packet that starts by resync (DLE <id> inside a
+// frame that lost its DLE ETX) in a later read is stamped from that
+// read, not from the broken frame's
+//////////////////////////////////////////////////////////////////////
+
+static void *
+resync_sender(void *arg) {
+	static const uint8_t broken[] = { 0x10, 0x41, 0x01, 0x02, 0x03 };
+	int fd = *(int *)arg;
+	TxPacket tx;
+	uint8_t buf[64];
+
+	if ( ::write(fd,broken,sizeof broken) == sizeof broken ) {
+		usleep(30000);			// Read on its own
+		make_r41(tx,buf,sizeof buf,3.0f);
+		(void)!::write(fd,tx.data(),tx.size());
+	}
+	close(fd);
+	return 0;
+}
+
+static void
+check_resync_stamp() {
+	Packet pkt;
+	pthread_t tid;
+	uint8_t *packet;
+	int sv[2], length;
+	bool ended;
+	double ms;
+	char detail[64];
+
+	if ( socketpair(AF_UNIX,SOCK_STREAM,0,sv) < 0 ) {
+		check("resync stamp",false,strerror(errno));
+		return;
+	}
+	pkt.open(0,1024,sv[0]);
+	pkt.set_gap_timeout(0);			// Only DLE <id> ends it
+
+	pthread_create(&tid,0,resync_sender,&sv[1]);
+	pkt.get(&packet,&length,ended);
+	pthread_join(tid,0);
+
+	ms = double(pkt.stamp().mono_end - pkt.stamp().mono_start) / 1e6;
+	snprintf(detail,sizeof detail,"start to end %.3f ms",ms);
+	check("resync stamp",ended && length == 11 && packet[0] == 0x41
+		&& pkt.framing().resyncs == 1 && ms < 15.0,detail);
+}
+
+//////////////////////////////////////////////////////////////////////
+// RxThread, lossless: a small ring and a slow consumer keep the
+// reader waiting for slots; every packet must still arrive, in order
+//////////////////////////////////////////////////////////////////////
+
+static const int lossless_pkts = 400;
+
+static void *
+lossless_sender(void *arg) {
+	int fd = *(int *)arg;
+	TxPacket tx;
+	uint8_t buf[64];
+
+	for ( int x=0; x<lossless_pkts; ++x ) {
+		make_r41(tx,buf,sizeof buf,float(x));
+		if ( ::write(fd,tx.data(),tx.size()) != (ssize_t)tx.size() )
+			break;
+	}
+	close(fd);
+	return 0;
+}
+
+static void
+check_lossless() {
+	Packet pkt;
+	RxThread rx;
+	RxThread::s_rxslot *slots;
+	pthread_t tid;
+	s_rxstats st;
+	int sv[2], got = 0, wrong = 0;
+	unsigned n;
+	char detail[64];
+
+	if ( socketpair(AF_UNIX,SOCK_STREAM,0,sv) < 0 ) {
+		check("rxthread lossless",false,strerror(errno));
+		return;
+	}
+	pkt.open(0,1024,sv[0]);
+	if ( !rx.start(pkt,4,64) ) {
+		check("rxthread lossless",false,"start failed");
+		return;
+	}
+	pthread_create(&tid,0,lossless_sender,&sv[1]);
+
+	while ( rx.wait(1000) > 0 ) {
+		n = rx.take(&slots);
+		for ( unsigned x=0; x<n; ++x, ++got ) {
+			const uint8_t *d = slots[x].data;
+			uint32_t u = uint32_t(d[1]) << 24 | d[2] << 16 | d[3] << 8 | d[4];
+			float tow;
+
+			memcpy(&tow,&u,sizeof tow);
+			if ( slots[x].length != 11 || d[0] != 0x41 || tow != float(got) )
+				++wrong;
+		}
+		if ( unsigned(got % 32) < n )
+			usleep(2000);		// Let the ring fill
+		rx.release(n);
+	}
+	pthread_join(tid,0);
+	rx.stop();
+
+	st = rx.stats();
+	snprintf(detail,sizeof detail,"%d packets, %lu waits",got,st.full_waits);
+	check("rxthread lossless",got == lossless_pkts && wrong == 0
+		&& st.overruns == 0 && st.full_waits > 0,detail);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Reactor and UringReactor at EOF: a receiver that closes mid frame
+// gets its partial packet (ended=false) before it is retired, with
+// no gap timeout involved, and the other receiver carries on
+//////////////////////////////////////////////////////////////////////
+
+struct s_eof_check {
+	int	ended;		// Packets ended by DLE ETX
+	int	partial;	// Packets ended otherwise
+	int	partial_len;
+};
+
+static void
+eof_rx(Packet&,RxPacket& rxpkt,bool ended,void *arg) {
+	s_eof_check& ec = *(s_eof_check *)arg;
+
+	if ( ended ) {
+		++ec.ended;
+	} else	{
+		++ec.partial;
+		ec.partial_len = rxpkt.size();
+	}
+}
+
+template <class R>
+static void
+check_eof_flush(R& reactor,const char *what) {
+	static const uint8_t broken[] = { 0x10, 0x41, 0x01, 0x02, 0x03 };
+	Packet pkt[2];
+	s_eof_check ec[2];
+	TxPacket tx;
+	uint8_t buf[64];
+	int sv[2][2], x;
+	bool ok = true;
+
+	for ( x=0; x<2; ++x ) {
+		if ( socketpair(AF_UNIX,SOCK_STREAM,0,sv[x]) < 0 ) {
+			check(what,false,strerror(errno));
+			return;
+		}
+		pkt[x].open(0,1024,sv[x][0]);
+		pkt[x].set_gap_timeout(60000);	// Not what ends it
+		memset(&ec[x],0,sizeof ec[x]);
+		ok = ok && reactor.add(pkt[x],eof_rx,&ec[x]) == x;
+		make_r41(tx,buf,sizeof buf,float(x));
+		ok = ok && ::write(sv[x][1],tx.data(),tx.size()) == tx.size();
+	}
+
+	ok = ok && ::write(sv[0][1],broken,sizeof broken) == sizeof broken;
+	close(sv[0][1]);			// EOF mid frame
+
+	for ( x=0; x<100 && reactor.active() > 1; ++x )
+		reactor.run_once(10);
+
+	make_r41(tx,buf,sizeof buf,2.0f);	// The other is still served
+	ok = ok && ::write(sv[1][1],tx.data(),tx.size()) == tx.size();
+	close(sv[1][1]);
+	for ( x=0; x<100 && reactor.active() > 0; ++x )
+		reactor.run_once(10);
+
+	check(what,ok && reactor.active() == 0
+		&& ec[0].ended == 1 && ec[0].partial == 1 && ec[0].partial_len == 4
+		&& ec[1].ended == 2 && ec[1].partial == 0);
+}
+
+static void
+check_reactors_eof() {
+	Reactor er;
+	UringReactor ur;
+
+	er.open(4);
+	check_eof_flush(er,"epoll EOF flush");
+	if ( ur.open(4) )
+		check_eof_flush(ur,"uring EOF flush");
+	else	check("uring EOF flush",true,"skipped: no io_uring");
+}
+
+//////////////////////////////////////////////////////////////////////
+// RptDispatch: a plain id and a super packet sub id reach their
+// handlers with the full id, positioned after it; unregistered ids,
+// removed ones, and truncated or empty packets are counted unhandled
+//////////////////////////////////////////////////////////////////////
+
+struct s_disp_check {
+	int		calls;
+	uint16_t	id;		// Last id passed
+	uint8_t		first;		// Byte after the id
+};
+
+static void
+disp_rpt(RxPacket& rxpkt,uint16_t id,void *arg) {
+	s_disp_check& dc = *(s_disp_check *)arg;
+
+	++dc.calls;
+	dc.id = id;
+	if ( !rxpkt.get(dc.first) )
+		dc.first = 0;
+}
+
+// Load len bytes and dispatch them; true if the handler took it
+static bool
+disp_one(RptDispatch& disp,s_disp_check& dc,const uint8_t *bytes,uint16_t len) {
+	uint8_t buf[16];
+	RxPacket rxpkt;
+	int calls = dc.calls;
+
+	memcpy(buf,bytes,len);
+	rxpkt.load(buf,len);
+	return disp.dispatch(rxpkt) && dc.calls == calls + 1;
+}
+
+static void
+check_rptdisp() {
+	static const uint8_t r84[] = { 0x84, 0x55 };
+	static const uint8_t r8FAB[] = { 0x8F, 0xAB, 0x66 };
+	static const uint8_t r41[] = { 0x41, 0x00 };
+	static const uint8_t r8F20[] = { 0x8F, 0x20, 0x00 };
+	static const uint8_t r8F[] = { 0x8F };
+	static const uint8_t r6E[] = { 0x6E };
+	RptDispatch disp;
+	s_disp_check dc;
+	bool ok;
+
+	dc.calls = 0;
+	dc.id = 0;
+	dc.first = 0;
+
+	ok = disp.add(0x84,disp_rpt,&dc) && disp.add(0x8FAB,disp_rpt,&dc);
+	ok = ok && !disp.add(0x8F,disp_rpt,&dc) && !disp.add(0x84AB,disp_rpt,&dc);
+	check("dispatch add",ok);
+
+	ok = disp_one(disp,dc,r84,sizeof r84) && dc.id == 0x84 && dc.first == 0x55;
+	ok = ok && disp_one(disp,dc,r8FAB,sizeof r8FAB) && dc.id == 0x8FAB && dc.first == 0x66;
+	check("dispatch registered",ok && disp.dispatched() == 2 && disp.unhandled() == 0);
+
+	ok = !disp_one(disp,dc,r41,sizeof r41)		// Plain, no handler
+	  && !disp_one(disp,dc,r8F20,sizeof r8F20)	// Sub id, no handler
+	  && !disp_one(disp,dc,r6E,sizeof r6E);	// Super, no sub table
+	check("dispatch unregistered",ok && dc.calls == 2 && disp.unhandled() == 3);
+
+	ok = !disp_one(disp,dc,r8F,sizeof r8F)		// No sub id
+	  && !disp_one(disp,dc,r8F,0);			// Empty
+	check("dispatch truncated",ok && dc.calls == 2 && disp.unhandled() == 5);
+
+	disp.remove(0x84);
+	disp.remove(0x8FAB);
+	ok = !disp_one(disp,dc,r84,sizeof r84) && !disp_one(disp,dc,r8FAB,sizeof r8FAB);
+	check("dispatch removed",ok && dc.calls == 2
+		&& disp.dispatched() == 2 && disp.unhandled() == 7);
+}
+
+//////////////////////////////////////////////////////////////////////
+// RxView against get() on the same packet: 84 in single and double
+// precision, 6D with satellites, and a 6D too short for either
+//////////////////////////////////////////////////////////////////////
+
+// Append v big endian, as the receiver sends it
+static void
+put_be(std::vector<uint8_t>& into,const void *v,unsigned size) {
+	for ( unsigned x=size; x-- > 0; )
+		into.push_back(((const uint8_t *)v)[x]);
+}
+
+static bool
+view_84(bool sd) {
+	std::vector<uint8_t> bytes(1,0x84);
+	const double vals[5] = { 0.7, -1.3, 123.25, 4.5, 302400.5 };
+	const float tof1 = 302400.5f;
+	RxPacket rxpkt;
+	s_R84 r;
+
+	for ( int x=0; x<(sd ? 5 : 4); ++x )
+		put_be(bytes,&vals[x],sizeof vals[x]);
+	if ( !sd )
+		put_be(bytes,&tof1,sizeof tof1);
+
+	rxpkt.load(bytes.data(),bytes.size());
+	rxpkt.set_precision(sd);
+	rxpkt.id();
+	if ( !rxpkt.get(r) )
+		return false;
+
+	rxpkt.load(bytes.data(),bytes.size());
+	rxpkt.id();
+	RxView<s_R84> v(rxpkt);
+
+	return v.valid() && rxpkt.get_offset() == bytes.size()
+		&& v.latitude() == r.latitude && v.longitude() == r.longitude
+		&& v.altitude() == r.altitude && v.clock_bias() == r.clock_bias
+		&& v.time_of_fix() == (sd ? r.u.time_of_fix2 : double(r.u.time_of_fix1));
+}
+
+static bool
+view_6D(unsigned nsv,bool whole) {
+	std::vector<uint8_t> bytes(1,0x6D);
+	const float dops[4] = { 1.5f, 0.9f, 1.2f, 0.8f };
+	RxPacket rxpkt;
+	s_R6D r;
+	bool got;
+
+	bytes.push_back(0x04);
+	for ( int x=0; x<4; ++x )
+		put_be(bytes,&dops[x],sizeof dops[x]);
+	for ( unsigned x=0; x<nsv; ++x )
+		bytes.push_back(uint8_t(3 + x * 2));
+	if ( !whole )
+		bytes.resize(bytes.size() - 2);
+
+	rxpkt.load(bytes.data(),bytes.size());
+	rxpkt.id();
+	got = rxpkt.get(r);
+
+	rxpkt.load(bytes.data(),bytes.size());
+	rxpkt.id();
+	RxView<s_R6D> v(rxpkt);
+
+	if ( !got )
+		return !v.valid() && v.count() == 0;
+	if ( !v.valid() || v.count() != r.n || v.fixmode() != r.fixmode
+	  || v.pdop() != r.pdop || v.hdop() != r.hdop
+	  || v.vdop() != r.vdop || v.tdop() != r.tdop )
+		return false;
+	for ( unsigned x=0; x<v.count(); ++x )
+		if ( v.sv_prn(x) != r.sv_prn[x] )
+			return false;
+	return true;
+}
+
+static void
+check_rxview() {
+
+	check("view 84 single",view_84(false));
+	check("view 84 double",view_84(true));
+	check("view 6D",view_6D(6,true) && view_6D(0,true));
+	check("view 6D short",view_6D(0,false));
+}
+
+//////////////////////////////////////////////////////////////////////
+// decode(): every report in TSIP_REPORTS, hand written or generated,
+// reaches its own decoder, not s_RxUnknown. The packet is all zeros
+// after the id, which a decoder may refuse (58: no such datatype), so
+// s_RxError counts as reached too.
+//////////////////////////////////////////////////////////////////////
+
+template <class R>
+static bool
+decodes_as(uint16_t id,int& refused) {
+	static uint8_t buf[1024];
+	RxPacket rxpkt;
+	int n = 0;
+
+	memset(buf,0,sizeof buf);
+	if ( id > 0xFF )
+		buf[n++] = id >> 8;
+	buf[n++] = id & 0xFF;
+	rxpkt.load(buf,sizeof buf);
+	RxReport rpt = decode(rxpkt);
+
+	refused += std::holds_alternative<s_RxError>(rpt);
+	return std::holds_alternative<R>(rpt) || std::holds_alternative<s_RxError>(rpt);
+}
+
+static void
+check_registry() {
+	int nrpts = 0, missed = 0, refused = 0;
+	char detail[64];
+
+#define TSIP_CHECK(id_,rec)						\
+	++nrpts;							\
+	if ( !decodes_as<rec>(id_,refused) && !missed++ )		\
+		snprintf(detail,sizeof detail,"first miss %s",#rec);
+
+	TSIP_REPORTS(TSIP_CHECK)
+	TSIP_CHECK(0x13,s_R13)		// Generated: in the list via rlist.h
+	TSIP_CHECK(0x5F,s_R5F)		// Plain report under a super id
+	TSIP_CHECK(0x8F7F,s_R8F7F)
+
+#undef TSIP_CHECK
+	if ( !missed )
+		snprintf(detail,sizeof detail,"%d checked, %d refused zeros",nrpts,refused);
+	check("decode() registry",missed == 0,detail);
+}
+
+//////////////////////////////////////////////////////////////////////
+// RptBatch against get() over the same mixed span: whole and short
+// 84, 56, 6D (0 to 40 satellites) and 5A reports, other ids and empty
+// packets, in both precisions, with a capacity small enough that
+// decode() stops early and is called again for the rest
+//////////////////////////////////////////////////////////////////////
+
+static uint32_t batch_seed;
+
+// Deterministic filler bytes
+static uint8_t
+batch_byte() {
+	batch_seed = batch_seed * 1103515245u + 12345u;
+	return batch_seed >> 16;
+}
+
+template <class T>
+static bool
+same(const T& a,const T& b) {
+	return !memcmp(&a,&b,sizeof a);
+}
+
+struct s_batch_want {
+	std::vector<s_R84> r84;
+	std::vector<s_R56> r56;
+	std::vector<s_R6D> r6D;
+	std::vector<s_R5A> r5A;
+	unsigned long others;
+	unsigned long shorts;
+};
+
+static bool
+batch_pass(bool sd,char *detail,size_t dsize) {
+	static const struct {
+		uint8_t	id;
+		int	bytes;			// After the id
+	} kinds[] = {
+		{ 0x84, 36 }, { 0x84, 40 }, { 0x84, 20 },
+		{ 0x56, 20 }, { 0x56, 24 }, { 0x56, 1 },
+		{ 0x6D, 17 }, { 0x6D, 22 }, { 0x6D, 50 }, { 0x6D, 57 }, { 0x6D, 10 },
+		{ 0x5A, 25 }, { 0x5A, 24 },
+		{ 0x41, 10 }, { 0x8F, 20 },
+		{ 0x00, -1 }			// Empty packet
+	};
+	const unsigned nkinds = sizeof kinds / sizeof kinds[0];
+	const unsigned npkts = 120, rows = 3;
+	std::vector<std::vector<uint8_t> > store(npkts);
+	std::vector<s_pktref> refs(npkts);
+	s_batch_want want;
+	RxPacket rxpkt;
+	RptBatch batch;
+	unsigned x, done, k, early = 0, i84 = 0, i56 = 0, i6D = 0, i5A = 0;
+	unsigned long others = 0, shorts = 0;
+
+	batch_seed = sd ? 2 : 1;
+	want.others = want.shorts = 0;
+	for ( x=0; x<npkts; ++x ) {
+		unsigned kx = (x * 7 + x / nkinds) % nkinds;
+		std::vector<uint8_t>& pkt = store[x];
+
+		if ( kinds[kx].bytes >= 0 ) {
+			pkt.push_back(kinds[kx].id);
+			for ( int y=0; y<kinds[kx].bytes; ++y )
+				pkt.push_back(batch_byte());
+		}
+		refs[x].data = pkt.data();
+		refs[x].length = pkt.size();
+
+		// What get() makes of it
+		if ( pkt.empty() ) {
+			++want.shorts;
+			continue;
+		}
+		rxpkt.load(pkt.data(),pkt.size());
+		rxpkt.set_precision(sd);
+		switch ( rxpkt.id() ) {
+		case 0x84 :
+			want.r84.resize(want.r84.size() + 1);
+			if ( !rxpkt.get(want.r84.back()) ) {
+				want.r84.pop_back();
+				++want.shorts;
+			}
+			break;
+		case 0x56 :
+			want.r56.resize(want.r56.size() + 1);
+			if ( !rxpkt.get(want.r56.back()) ) {
+				want.r56.pop_back();
+				++want.shorts;
+			}
+			break;
+		case 0x6D :
+			want.r6D.resize(want.r6D.size() + 1);
+			if ( !rxpkt.get(want.r6D.back()) ) {
+				want.r6D.pop_back();
+				++want.shorts;
+			}
+			break;
+		case 0x5A :
+			want.r5A.resize(want.r5A.size() + 1);
+			if ( !rxpkt.get(want.r5A.back()) ) {
+				want.r5A.pop_back();
+				++want.shorts;
+			}
+			break;
+		default :
+			++want.others;
+		}
+	}
+
+	batch.open(rows);
+	batch.set_precision(sd);
+	for ( done=0; done<npkts; done += k ) {
+		batch.clear();
+		k = batch.decode(refs.data() + done,npkts - done);
+		if ( k == 0 ) {
+			snprintf(detail,dsize,"no progress at %u",done);
+			return false;
+		}
+		early += done + k < npkts;
+		others += batch.others();
+		shorts += batch.short_packets();
+
+		const s_cols84& c84 = batch.cols84();
+		for ( x=0; x<batch.rows84(); ++x, ++i84 ) {
+			const s_R84& r = want.r84.at(i84);
+			double tof = sd ? r.u.time_of_fix2 : double(r.u.time_of_fix1);
+
+			if ( !same(c84.latitude[x],r.latitude) || !same(c84.longitude[x],r.longitude)
+			  || !same(c84.altitude[x],r.altitude) || !same(c84.clock_bias[x],r.clock_bias)
+			  || !same(c84.time_of_fix[x],tof) ) {
+				snprintf(detail,dsize,"84 row %u differs",i84);
+				return false;
+			}
+		}
+		const s_cols56& c56 = batch.cols56();
+		for ( x=0; x<batch.rows56(); ++x, ++i56 ) {
+			const s_R56& r = want.r56.at(i56);
+			double tof = sd ? r.u.time_of_fix2 : double(r.u.time_of_fix1);
+
+			if ( !same(c56.eastvel[x],r.eastvel) || !same(c56.northvel[x],r.northvel)
+			  || !same(c56.upvel[x],r.upvel) || !same(c56.clock_bias_rate[x],r.clock_bias_rate)
+			  || !same(c56.time_of_fix[x],tof) ) {
+				snprintf(detail,dsize,"56 row %u differs",i56);
+				return false;
+			}
+		}
+		const s_cols6D& c6D = batch.cols6D();
+		for ( x=0; x<batch.rows6D(); ++x, ++i6D ) {
+			const s_R6D& r = want.r6D.at(i6D);
+
+			if ( c6D.fixmode[x] != r.fixmode || !same(c6D.pdop[x],r.pdop)
+			  || !same(c6D.hdop[x],r.hdop) || !same(c6D.vdop[x],r.vdop)
+			  || !same(c6D.tdop[x],r.tdop) || c6D.nsv[x] != r.n
+			  || memcmp(c6D.sv_prn + c6D.sv_first[x],r.sv_prn,r.n) ) {
+				snprintf(detail,dsize,"6D row %u differs",i6D);
+				return false;
+			}
+		}
+		const s_cols5A& c5A = batch.cols5A();
+		for ( x=0; x<batch.rows5A(); ++x, ++i5A ) {
+			const s_R5A& r = want.r5A.at(i5A);
+
+			if ( c5A.sv_prn[x] != r.sv_prn || !same(c5A.samplength[x],r.samplength)
+			  || !same(c5A.siglevel[x],r.siglevel) || !same(c5A.code_phase[x],r.code_phase)
+			  || !same(c5A.doppler[x],r.doppler) || !same(c5A.time[x],r.time) ) {
+				snprintf(detail,dsize,"5A row %u differs",i5A);
+				return false;
+			}
+		}
+	}
+
+	snprintf(detail,dsize,"%u/%u/%u/%u rows, %u early returns",i84,i56,i6D,i5A,early);
+	return i84 == want.r84.size() && i56 == want.r56.size()
+		&& i6D == want.r6D.size() && i5A == want.r5A.size()
+		&& others == want.others && shorts == want.shorts && early > 0;
+}
+
+static void
+check_rptbatch() {
+	char detail[80];
+	bool ok;
+
+	ok = batch_pass(false,detail,sizeof detail);
+	check("batch matches get()",ok,detail);
+	ok = batch_pass(true,detail,sizeof detail);
+	check("batch matches get() sd",ok,detail);
+}
+
+//////////////////////////////////////////////////////////////////////
+// be_swap32/be_swap64: every kernel the CPU supports against the
+// scalar one, for n = 0..40 (vector bodies, the AVX2 to 16 byte step
+// and scalar tails) with from and to each misaligned by 0..7 bytes,
+// leaving the bytes past the end alone
+//////////////////////////////////////////////////////////////////////
+
+static bool
+beswap_kernel(BeSwapKind kind,char *detail,size_t dsize) {
+	uint8_t src[8 + 40 * 8], got[8 + 40 * 8 + 16], want[8 + 40 * 8 + 16];
+	unsigned seed = 7;
+
+	for ( size_t x=0; x<sizeof src; ++x ) {
+		seed = seed * 1103515245u + 12345u;
+		src[x] = seed >> 16;
+	}
+
+	for ( int wide=0; wide<2; ++wide ) {
+		const size_t size = wide ? 8 : 4;
+
+		for ( size_t n=0; n<=40; ++n )
+			for ( int fo=0; fo<8; ++fo )
+				for ( int to=0; to<8; ++to ) {
+					memset(got,0xA5,sizeof got);
+					memset(want,0xA5,sizeof want);
+					if ( wide ) {
+						be_swap64(got + to,src + fo,n);
+						be_swap64_scalar(want + to,src + fo,n);
+					} else	{
+						be_swap32(got + to,src + fo,n);
+						be_swap32_scalar(want + to,src + fo,n);
+					}
+					if ( memcmp(got,want,sizeof got) ) {
+						snprintf(detail,dsize,"%s swap%d n=%u from+%d to+%d",
+							be_swap_name(kind),int(size * 8),unsigned(n),fo,to);
+						return false;
+					}
+				}
+	}
+	return true;
+}
+
+static void
+check_beswap() {
+	static const BeSwapKind kinds[] = { be_scalar, be_ssse3, be_avx2, be_neon };
+	BeSwapKind best = be_swap_kind();
+	char tested[48] = "", detail[80];
+	bool ok = true;
+
+	for ( unsigned x=0; ok && x<sizeof kinds / sizeof kinds[0]; ++x ) {
+		if ( !be_swap_select(kinds[x]) )
+			continue;
+		ok = beswap_kernel(kinds[x],detail,sizeof detail);
+		snprintf(tested + strlen(tested),sizeof tested - strlen(tested),"%s%s",
+			*tested ? " " : "",be_swap_name(kinds[x]));
+	}
+	be_swap_select(best);
+	check("be_swap kernels",ok,ok ? tested : detail);
+}
+
+//////////////////////////////////////////////////////////////////////
+// get_fixed() against the float path: each scaled integer must be
+// within 1 unit of lround(value * K), saturated to int32_t (NaN: 0),
+// for 4A, 56 and 84 in both precisions. Edge values (signed zeros,
+// subnormals, infinities, NaN, the saturation points, +-pi) come
+// first, then deterministic random bit patterns and realistic fixes.
+//////////////////////////////////////////////////////////////////////
+
+static const long double fx_deg7 = 1e7L * 180.0L / 3.14159265358979323846264338327950288L;
+
+struct s_fxfield {
+	unsigned	offset;		// After the id
+	bool		dbl;		// Sent as a double
+	long double	k;		// Scale to the fixed point unit
+};
+
+static uint64_t fx_seed;
+
+static uint64_t
+fx_random() {
+	fx_seed = fx_seed * 6364136223846793005ull + 1442695040888963407ull;
+	return fx_seed;
+}
+
+// Within 1 unit of round(v * k), saturated as fixpt.hpp documents
+// (exactly, for NaN and infinities)
+static bool
+fx_near(int32_t got,long double v,long double k) {
+	long double p = v * k;
+	long long want;
+
+	if ( isnan(v) )
+		return got == 0;
+	if ( isinf(v) )
+		return got == (v > 0 ? INT32_MAX : INT32_MIN);
+	if ( p >= INT32_MAX )
+		want = INT32_MAX;
+	else if ( p <= INT32_MIN )
+		want = INT32_MIN;
+	else	want = llroundl(p);
+	return llabs(got - want) <= 1;
+}
+
+// One report: values v[0..3] in the fields, as the wire type
+template <class FX>
+static bool
+fx_one(uint8_t id,const s_fxfield *f,bool sd,const long double *v) {
+	std::vector<uint8_t> bytes(64,0);
+	long double sent[4];
+	int32_t got[4];
+	RxPacket rxpkt;
+	FX fx;
+
+	bytes[0] = id;
+	for ( int x=0; x<4; ++x ) {
+		std::vector<uint8_t> be;
+
+		if ( f[x].dbl ) {
+			double d = double(v[x]);
+
+			put_be(be,&d,sizeof d);
+			sent[x] = d;
+		} else	{
+			float s = float(v[x]);
+
+			put_be(be,&s,sizeof s);
+			sent[x] = s;
+		}
+		memcpy(&bytes[1 + f[x].offset],be.data(),be.size());
+	}
+
+	rxpkt.load(bytes.data(),bytes.size());
+	rxpkt.set_precision(sd);
+	rxpkt.id();
+	if ( !get_fixed(rxpkt,fx) )
+		return false;
+	memcpy(got,&fx,sizeof got);		// Four int32_t, in field order
+	for ( int x=0; x<4; ++x )
+		if ( !fx_near(got[x],sent[x],f[x].k) )
+			return false;
+	return true;
+}
+
+// f[0..2] as the report sends them, then its time of fix
+template <class R,class FX>
+static bool
+fx_report(uint8_t id,const s_fxfield *f3,bool sd,char *detail,size_t dsize) {
+	typedef Layout<R> L;
+	const s_fxfield f[4] = {
+		f3[0], f3[1], f3[2],
+		{ sd ? L::time_of_fix2::offset : L::time_of_fix1::offset, sd, 1000.0L }
+	};
+	const long double inf = INFINITY, pi = 3.14159265358979323846264338327950288L;
+	const long double edges[] = {
+		0.0L, -0.0L, FLT_TRUE_MIN, -FLT_TRUE_MIN, DBL_TRUE_MIN, 1e-40L,
+		FLT_MIN, DBL_MIN, inf, -inf, NAN, -NAN, 1e30L, -1e30L, 1e300L,
+		pi, -pi, pi / 2, -pi / 2,
+		2147483.647L, -2147483.648L, 2147483.6475L, 21474836.47L, -21474836.48L,
+		0.5e-7L, 1.5e-3L, 2.5e-3L, 604799.999L, 0.0005L
+	};
+	const int nedges = sizeof edges / sizeof edges[0];
+	long double v[4];
+	int c, x;
+
+	for ( c=0; c<nedges; ++c ) {
+		for ( x=0; x<4; ++x )
+			v[x] = edges[(c + x * 7) % nedges];
+		if ( !fx_one<FX>(id,f,sd,v) )
+			goto fail;
+	}
+
+	fx_seed = id * 2 + sd;
+	for ( c=0; c<20000; ++c ) {
+		for ( x=0; x<4; ++x ) {
+			uint64_t r = fx_random();
+
+			if ( c & 1 ) {			// Any bits
+				if ( f[x].dbl ) {
+					double d;
+
+					memcpy(&d,&r,sizeof d);
+					v[x] = d;
+				} else	{
+					uint32_t u = r >> 32;
+					float s;
+
+					memcpy(&s,&u,sizeof s);
+					v[x] = s;
+				}
+			} else	{			// A plausible fix
+				long double unit = (r >> 11) * 0x1p-53L * 2 - 1;
+
+				v[x] = x < 2 ? unit * pi : x == 2 ? unit * 20000 : (unit + 1) * 302400;
+			}
+		}
+		if ( !fx_one<FX>(id,f,sd,v) )
+			goto fail;
+	}
+	return true;
+
+fail:	snprintf(detail,dsize,"%02X%s: %Lg %Lg %Lg %Lg",id,sd ? " sd" : "",v[0],v[1],v[2],v[3]);
+	return false;
+}
+
+static void
+check_fixpt() {
+	typedef Layout<s_R4A> L4A;
+	typedef Layout<s_R56> L56;
+	typedef Layout<s_R84> L84;
+	const s_fxfield f4A[3] = {
+		{ L4A::latitude::offset, false, fx_deg7 },
+		{ L4A::longitude::offset, false, fx_deg7 },
+		{ L4A::altitude::offset, false, 1000.0L }
+	};
+	const s_fxfield f56[3] = {
+		{ L56::eastvel::offset, false, 100.0L },
+		{ L56::northvel::offset, false, 100.0L },
+		{ L56::upvel::offset, false, 100.0L }
+	};
+	const s_fxfield f84[3] = {
+		{ L84::latitude::offset, true, fx_deg7 },
+		{ L84::longitude::offset, true, fx_deg7 },
+		{ L84::altitude::offset, true, 1000.0L }
+	};
+	char detail[128] = "4A, 56, 84 in both precisions";
+	bool ok = true;
+
+	for ( int sd=0; ok && sd<2; ++sd ) {
+		ok = fx_report<s_R4A,s_R4Afx>(0x4A,f4A,sd,detail,sizeof detail)
+		  && fx_report<s_R56,s_R56fx>(0x56,f56,sd,detail,sizeof detail)
+		  && fx_report<s_R84,s_R84fx>(0x84,f84,sd,detail,sizeof detail);
+	}
+	check("fixed point vs float",ok,detail);
+}
+
+int
+main(int argc,char **argv) {
+
+	(void)argc;
+	(void)argv;
+
+	check_uring();
+	check_short_reports();
+	check_pool_copy();
+	check_pool_slab();
+	check_resync_stamp();
+	check_reactors_eof();
+	check_lossless();
+	check_rptdisp();
+	check_rxview();
+	check_registry();
+	check_rptbatch();
+	check_beswap();
+	check_fixpt();
+	return failures;
+}
+
+// End rcheck.cpp
@@ -0,0 +1,174 @@
+//////////////////////////////////////////////////////////////////////
+// reactor.cpp -- epoll Reactor for Many Receivers
+// Date: Sun Oct 18 13:16:27 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <assert.h>
+
+#include "reactor.hpp"
+
+Reactor::Reactor() {
+	epfd = -1;
+	rcvrs = 0;
+	maxrcvrs = 0;
+	nrcvrs = 0;
+	nactive = 0;
+	stopping = false;
+	dispatched = 0;
+}
+
+Reactor::~Reactor() {
+	if ( epfd >= 0 )
+		close(epfd);
+	delete[] rcvrs;
+}
+
+void
+Reactor::open(int maxrcvrs) {
+
+	assert(epfd < 0);
+	if ( maxrcvrs <= 0 )
+		maxrcvrs = 128;
+
+	epfd = epoll_create1(EPOLL_CLOEXEC);
+	assert(epfd >= 0);
+
+	this->maxrcvrs = maxrcvrs;
+	rcvrs = new s_receiver[maxrcvrs];
+}
+
+//////////////////////////////////////////////////////////////////////
+// Register an opened Packet and the handler for its packets
+//
+// RETURNS:
+//	Receiver index (for rxpacket()), or -1 if the table is full
+//	or the fd cannot be polled (e.g. a regular file)
+//////////////////////////////////////////////////////////////////////
+
+int
+Reactor::add(Packet& pkt,rxhandler_t handler,void *arg) {
+	struct epoll_event ev;
+
+	if ( nrcvrs >= maxrcvrs )
+		return -1;
+
+	s_receiver& rcvr = rcvrs[nrcvrs];
+
+	rcvr.reactor = this;
+	rcvr.pkt = &pkt;
+	rcvr.handler = handler;
+	rcvr.arg = arg;
+	rcvr.active = true;
+
+	ev.events = EPOLLIN;
+	ev.data.ptr = &rcvr;
+	if ( epoll_ctl(epfd,EPOLL_CTL_ADD,pkt.fd(),&ev) < 0 )
+		return -1;
+
+	++nactive;
+	return nrcvrs++;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Retire a receiver at EOF or on an error, first delivering the
+// packet it was framing (ended=false), as a gap timeout would
+//////////////////////////////////////////////////////////////////////
+
+void
+Reactor::remove(s_receiver& rcvr) {
+
+	rcvr.pkt->flush(deliver,&rcvr);
+	epoll_ctl(epfd,EPOLL_CTL_DEL,rcvr.pkt->fd(),0);
+	rcvr.active = false;
+	--nactive;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Framer callback: load the receiver's RxPacket and dispatch
+//////////////////////////////////////////////////////////////////////
+
+void
+Reactor::deliver(void *arg,uint8_t *packet,int length,bool ended) {
+	s_receiver& rcvr = *(s_receiver *)arg;
+
+	rcvr.rxpkt.load(packet,length);
+	rcvr.handler(*rcvr.pkt,rcvr.rxpkt,ended,rcvr.arg);
+	++rcvr.reactor->dispatched;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Milliseconds until the nearest partial packet times out, or -1
+//////////////////////////////////////////////////////////////////////
+
+int
+Reactor::timeout() {
+	int ms = -1, left;
+
+	for ( int x=0; x<nrcvrs; ++x ) {
+		if ( !rcvrs[x].active )
+			continue;
+		left = rcvrs[x].pkt->gap_left();
+		if ( left >= 0 && (ms < 0 || left < ms) )
+			ms = left;
+	}
+	return ms;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Wait up to ms (-1 = until data or a gap timeout) and service all
+// ready receivers
+//
+// RETURNS:
+//	>= 0	- Number of packets dispatched
+//	-1	- No active receivers left
+//////////////////////////////////////////////////////////////////////
+
+int
+Reactor::run_once(int ms) {
+	struct epoll_event evs[64];
+	unsigned long before = dispatched;
+	int gap, n, rc;
+
+	if ( nactive <= 0 )
+		return -1;
+
+	gap = timeout();
+	if ( gap >= 0 && (ms < 0 || gap < ms) )
+		ms = gap;
+
+	do	{
+		n = epoll_wait(epfd,evs,64,ms);
+	} while ( n < 0 && errno == EINTR );
+	assert(n >= 0);
+
+	for ( int x=0; x<n; ++x ) {
+		s_receiver& rcvr = *(s_receiver *)evs[x].data.ptr;
+
+		if ( !rcvr.active )
+			continue;
+		rc = rcvr.pkt->pump(deliver,&rcvr);
+		if ( rc < 0 )
+			remove(rcvr);
+	}
+
+	if ( gap >= 0 ) {
+		for ( int x=0; x<nrcvrs; ++x )
+			if ( rcvrs[x].active )
+				rcvrs[x].pkt->expire(deliver,&rcvrs[x]);
+	}
+
+	return int(dispatched - before);
+}
+
+void
+Reactor::run() {
+
+	stopping = false;
+	while ( !stopping && run_once() >= 0 )
+		;
+}
+
+// End reactor.cpp
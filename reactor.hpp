@@ -0,0 +1,70 @@
+//////////////////////////////////////////////////////////////////////
+// reactor.hpp -- epoll Reactor for Many Receivers
+// Date: Sun Oct 18 13:10:51 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#include <stdint.h>
+
+#include "ttyio.hpp"
+#include "tsip.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Handler for a received packet. rxpkt is loaded with the packet
+// (use rxpkt.id() then rxpkt.get(...)) and is only valid during the
+// call. Each receiver has its own RxPacket, so set_precision() is
+// per receiver.
+//////////////////////////////////////////////////////////////////////
+
+typedef void (*rxhandler_t)(Packet& pkt,RxPacket& rxpkt,bool ended,void *arg);
+
+//////////////////////////////////////////////////////////////////////
+// Drive many opened Packet objects from one thread. Each receiver
+// is framed independently; one epoll_wait() services every ready fd
+// with a single read() each. The epoll timeout is the nearest
+// partial packet gap timeout, so idle receivers cost nothing.
+//////////////////////////////////////////////////////////////////////
+
+class Reactor {
+	struct s_receiver {
+		Reactor		*reactor;
+		Packet		*pkt;
+		rxhandler_t	handler;
+		void		*arg;
+		RxPacket	rxpkt;
+		bool		active;		// Registered and not at EOF
+	};
+
+	int	epfd;		// epoll fd
+	s_receiver *rcvrs;	// Receiver table
+	int	maxrcvrs;	// Size of rcvrs[]
+	int	nrcvrs;		// Receivers added
+	int	nactive;	// Receivers not at EOF
+	bool	stopping;	// stop() called
+	unsigned long dispatched; // Packets passed to handlers
+
+protected:
+	static void deliver(void *arg,uint8_t *packet,int length,bool ended);
+	void remove(s_receiver& rcvr);
+	int timeout();				// Nearest gap timeout (ms)
+
+public:	Reactor();
+	~Reactor();
+
+	void open(int maxrcvrs=128);
+	int add(Packet& pkt,rxhandler_t handler,void *arg=0);
+	inline RxPacket& rxpacket(int rx) { return rcvrs[rx].rxpkt; }
+
+	int run_once(int ms=-1);		// One epoll_wait() round
+	void run();				// Until stop() or all at EOF
+	inline void stop() { stopping = true; }
+
+	inline int active() const { return nactive; }
+	inline unsigned long packets() const { return dispatched; }
+};
+
+#endif // REACTOR_HPP
+
+// End reactor.hpp
@@ -0,0 +1,678 @@
+//////////////////////////////////////////////////////////////////////
+// rgen.cpp -- Generate Report Structs, Decoders and Lengths (msgs.dat)
+// Date: Sun Oct 18 21:40:17 2026
+///////////////////////////////////////////////////////////////////////
+//
+// Usage: rgen msgs.dat tsip.hpp
+//
+// Writes, in the current directory:
+//
+//	rstruct.h	- struct s_R<id>[<subid>] per report
+//	rget.h		- RxPacket::get() declarations (inside RxPacket)
+//	rdecode.cpp	- RxPacket::get() decoders
+//	rlength.h	- Length rule rows for tsiplen.cpp
+//	rsuper.h	- Ids with sub ids (tsip_super[] in tsip.cpp)
+//	rlist.h		- TSIP_GENERATED(X): X(full id,struct) per decoder,
+//			  for TSIP_REPORTS in msgtraits.hpp
+//
+// Reports with a hand written struct in tsip.hpp (enums, unions,
+// bit fields, repeated records) keep it, and get no struct or
+// decoder here. Every report gets a length rule.
+//
+// msgs.dat holds one block per report:
+//
+//	R <id> <subid or -> <title>
+//	<offset> <type> <name> <description>
+//
+// with offsets counted from the byte after the id (a sub id is at
+// offset 0), an offset range a-b (or a-n: to the end) for byte
+// arrays, and types byte, integer, long, single, double and
+// single:double:state_sd (per RxPacket::set_precision()).
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+
+static const int open_max = 255;	// Capacity of a-n byte arrays
+
+enum e_type {
+	t_byte,
+	t_integer,
+	t_long,
+	t_single,
+	t_double,
+	t_single_double		// Per state_sd
+};
+
+static const struct {
+	const char	*name;
+	e_type		type;
+	int		size;		// Bytes (single for t_single_double)
+	const char	*ctype;
+} types[] = {
+	{ "byte",		t_byte,		1, "uint8_t" },
+	{ "integer",		t_integer,	2, "int16_t" },
+	{ "long",		t_long,		4, "int32_t" },
+	{ "single",		t_single,	4, "float" },
+	{ "double",		t_double,	8, "double" },
+	{ "single:double:state_sd", t_single_double, 4, 0 },
+	{ 0, t_byte, 0, 0 }
+};
+
+struct s_field {
+	int		start;		// Offset after the id
+	int		end;		// Last offset of a range, -1 if to the end
+	bool		range;		// a-b or a-n byte array
+	int		tx;		// types[] index
+	std::string	name;		// C++ member name
+	std::string	desc;
+};
+
+struct s_report {
+	int		id;
+	int		subid;		// -1 if none
+	std::string	title;
+	std::string	note;		// Appended to the length rule comment
+	std::vector<s_field> fields;
+};
+
+//////////////////////////////////////////////////////////////////////
+// Corrections to msgs.dat
+//////////////////////////////////////////////////////////////////////
+
+static const struct {
+	int	id, subid;		// As in msgs.dat
+	int	newid;			// Actual report id
+} renames[] = {
+	{ 0x81, 0x71, 0x8F },		// A typo: the 8F 71 report
+	{ 0, 0, 0 }
+};
+
+//////////////////////////////////////////////////////////////////////
+// Length rules for reports whose hand written decoder takes less (or
+// more) than msgs.dat lays out: minlen is the id plus the prefix the
+// decoder requires, so the framer never drops a frame get() accepts
+//////////////////////////////////////////////////////////////////////
+
+static const struct {
+	int	id, subid;
+	int	minlen;			// Shortest useful length
+	int	maxlen;			// 0: no limit, -1: from msgs.dat
+} minimums[] = {
+	{ 0x43, -1, 9, -1 },		// Layout<s_R43>::min: x, y velocity
+	{ 0x45, -1, 11, -1 },		// Firmware dependent tail
+	{ 0x46, -1, 2, -1 },		// Status; error code zeroed if absent
+	{ 0x47, -1, 2, 0 },		// Count; any number of satellites
+	{ 0x48, -1, 1, -1 },		// Message text, possibly short
+	{ 0x49, -1, 1, -1 },		// Health bytes, zeroed if absent
+	{ 0x4A, -1, 9, -1 },		// Layout<s_R4A>::min: latitude, longitude
+	{ 0x4B, -1, 2, -1 },		// Machine id; status zeroed if absent
+	{ 0x59, -1, 2, -1 },		// Operation; flags zeroed if absent
+	{ 0x5B, -1, 8, -1 },		// Layout<s_R5B>::min: through iode
+	{ 0x6D, -1, 18, -1 },		// Count of satellites in view
+	{ 0x82, -1, 2, -1 },		// Mode; the rest zeroed if absent
+	{ 0, 0, 0, 0 }
+};
+
+static const char *keywords[] = {
+	"auto", "bool", "break", "case", "catch", "char", "class", "const",
+	"continue", "default", "delete", "do", "double", "else", "enum",
+	"extern", "false", "float", "for", "friend", "goto", "if", "inline",
+	"int", "long", "namespace", "new", "operator", "private", "protected",
+	"public", "register", "return", "short", "signed", "sizeof", "static",
+	"struct", "switch", "template", "this", "throw", "true", "try",
+	"typedef", "union", "unsigned", "using", "virtual", "void", "volatile",
+	"while", "u", 0
+};
+
+static const char *msgs_path = 0;
+static int lineno = 0;
+
+static void
+fatal(const char *msg,const char *arg="") {
+	fprintf(stderr,"%s:%d: %s%s\n",msgs_path,lineno,msg,arg);
+	exit(1);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Make a field name a unique C++ identifier within its report
+//////////////////////////////////////////////////////////////////////
+
+static std::string
+identifier(const std::string& name,int start,std::set<std::string>& used) {
+	std::string id;
+
+	for ( size_t x=0; x<name.size(); ++x )
+		id += isalnum((unsigned char)name[x]) ? name[x] : '_';
+	if ( id.empty() || isdigit((unsigned char)id[0]) )
+		id = "f" + id;
+	for ( int x=0; keywords[x]; ++x )
+		if ( id == keywords[x] ) {
+			id += '_';
+			break;
+		}
+	if ( used.count(id) ) {
+		char sfx[16];
+
+		snprintf(sfx,sizeof sfx,"_%d",start);
+		id += sfx;
+	}
+	used.insert(id);
+	return id;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Read msgs.dat
+//////////////////////////////////////////////////////////////////////
+
+static void
+load(const char *path,std::vector<s_report>& reports) {
+	FILE *f = fopen(path,"r");
+	char line[1024], *p, *ep, *tok;
+	std::set<std::string> used;
+
+	if ( !f ) {
+		perror(path);
+		exit(1);
+	}
+	msgs_path = path;
+
+	while ( fgets(line,sizeof line,f) ) {
+		++lineno;
+		if ( (p = strpbrk(line,"\r\n")) != 0 )
+			*p = 0;
+		for ( p=line; isspace((unsigned char)*p); ++p )
+			;
+		if ( !*p || *p == '#' )
+			continue;
+
+		if ( *p == 'R' && isspace((unsigned char)p[1]) ) {
+			s_report rpt;
+
+			rpt.id = strtol(p+1,&ep,16);
+			p = ep;
+			while ( isspace((unsigned char)*p) )
+				++p;
+			if ( *p == '-' ) {
+				rpt.subid = -1;
+				++p;
+			} else	{
+				rpt.subid = strtol(p,&ep,16);
+				if ( ep == p )
+					fatal("bad sub id");
+				p = ep;
+			}
+			while ( isspace((unsigned char)*p) )
+				++p;
+			rpt.title = p;
+			while ( !rpt.title.empty() && isspace((unsigned char)rpt.title.back()) )
+				rpt.title.erase(rpt.title.size()-1);
+
+			if ( rpt.id == 0x10 )
+				break;			// R 10 : End
+			for ( int x=0; renames[x].id; ++x )
+				if ( renames[x].id == rpt.id && renames[x].subid == rpt.subid ) {
+					char note[64];
+
+					snprintf(note,sizeof note," (msgs.dat: %02X %02X)",rpt.id,rpt.subid);
+					rpt.note = note;
+					rpt.id = renames[x].newid;
+				}
+			reports.push_back(rpt);
+			used.clear();
+			continue;
+		}
+
+		if ( reports.empty() )
+			fatal("field before first report");
+
+		s_field fld;
+
+		fld.start = strtol(p,&ep,10);
+		if ( ep == p )
+			fatal("bad offset");
+		fld.range = *ep == '-';
+		fld.end = fld.start;
+		if ( fld.range ) {
+			p = ep + 1;
+			if ( *p == 'n' ) {
+				fld.end = -1;
+				ep = p + 1;
+			} else	{
+				fld.end = strtol(p,&ep,10);
+				if ( ep == p || fld.end < fld.start )
+					fatal("bad offset range");
+			}
+		}
+
+		p = ep;
+		if ( !(tok = strtok(p," \t")) )
+			fatal("missing type");
+		for ( fld.tx=0; types[fld.tx].name; ++fld.tx )
+			if ( !strcmp(tok,types[fld.tx].name) )
+				break;
+		if ( !types[fld.tx].name )
+			fatal("unknown type ",tok);
+		if ( fld.range && types[fld.tx].type != t_byte )
+			fatal("offset range of non-byte type ",tok);
+
+		if ( !(tok = strtok(0," \t")) )
+			tok = (char *)"reserved";
+		fld.name = identifier(tok,fld.start,used);
+		if ( (tok = strtok(0,"")) != 0 ) {
+			while ( isspace((unsigned char)*tok) )
+				++tok;
+			fld.desc = tok;
+			while ( !fld.desc.empty() && isspace((unsigned char)fld.desc.back()) )
+				fld.desc.erase(fld.desc.size()-1);
+		}
+		reports.back().fields.push_back(fld);
+	}
+	fclose(f);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Names of the structs written by hand in tsip.hpp
+//////////////////////////////////////////////////////////////////////
+
+static void
+hand_written(const char *path,std::set<std::string>& names) {
+	FILE *f = fopen(path,"r");
+	char line[1024], name[64];
+
+	if ( !f ) {
+		perror(path);
+		exit(1);
+	}
+	while ( fgets(line,sizeof line,f) )
+		if ( sscanf(line,"struct s_R%63[0-9A-Fa-f]",name) == 1 )
+			names.insert(name);
+	fclose(f);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Report details
+//////////////////////////////////////////////////////////////////////
+
+static std::string
+suffix(const s_report& rpt) {
+	char buf[8];
+
+	if ( rpt.subid < 0 )
+		snprintf(buf,sizeof buf,"%02X",rpt.id);
+	else	snprintf(buf,sizeof buf,"%02X%02X",rpt.id,rpt.subid);
+	return buf;
+}
+
+static bool
+is_open(const s_field& fld) {
+	return fld.range && fld.end < 0;
+}
+
+static bool
+is_sd(const s_field& fld) {
+	return types[fld.tx].type == t_single_double;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Packet lengths (including the id): min with single precision and
+// empty a-n arrays, max with double precision (0: no limit)
+//////////////////////////////////////////////////////////////////////
+
+static void
+lengths(const s_report& rpt,int& minlen,int& maxlen) {
+	int lo = rpt.subid >= 0 ? 1 : 0, hi = lo, end;
+	bool open = false;
+
+	for ( size_t x=0; x<rpt.fields.size(); ++x ) {
+		const s_field& fld = rpt.fields[x];
+
+		if ( is_open(fld) ) {
+			open = true;
+			end = fld.start;
+		} else if ( fld.range )
+			end = fld.end + 1;
+		else	end = fld.start + types[fld.tx].size;
+		lo = std::max(lo,end);
+		hi = std::max(hi,is_sd(fld) ? fld.start + 8 : end);
+	}
+	minlen = 1 + lo;
+	maxlen = open ? 0 : 1 + hi;
+
+	for ( int x=0; minimums[x].id; ++x )
+		if ( minimums[x].id == rpt.id && minimums[x].subid == rpt.subid ) {
+			minlen = minimums[x].minlen;
+			if ( minimums[x].maxlen >= 0 )
+				maxlen = minimums[x].maxlen;
+		}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Check a report can be decoded at fixed offsets: at most one
+// variable sized field, and nothing after it
+//////////////////////////////////////////////////////////////////////
+
+static bool
+decodable(const s_report& rpt) {
+	int var = -1;
+
+	for ( size_t x=0; x<rpt.fields.size(); ++x ) {
+		const s_field& fld = rpt.fields[x];
+
+		if ( is_open(fld) || is_sd(fld) ) {
+			if ( var >= 0 )
+				return false;
+			var = fld.start;
+		}
+	}
+	if ( var < 0 )
+		return true;
+	for ( size_t x=0; x<rpt.fields.size(); ++x )
+		if ( rpt.fields[x].start > var )
+			return false;
+	return true;
+}
+
+static FILE *
+create(const char *path,const char *desc) {
+	FILE *f = fopen(path,"w");
+
+	if ( !f ) {
+		perror(path);
+		exit(1);
+	}
+	fprintf(f,"//////////////////////////////////////////////////////////////////////\n");
+	fprintf(f,"// %s -- %s\n",path,desc);
+	fprintf(f,"// Generated by rgen from msgs.dat: do not edit\n");
+	fprintf(f,"///////////////////////////////////////////////////////////////////////\n\n");
+	return f;
+}
+
+static void
+finish(FILE *f,const char *path) {
+
+	fprintf(f,"// End %s\n",path);
+	if ( fclose(f) ) {
+		perror(path);
+		exit(1);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// rstruct.h
+//////////////////////////////////////////////////////////////////////
+
+static void
+gen_structs(const std::vector<const s_report *>& rpts) {
+	FILE *f = create("rstruct.h","Report Structs");
+
+	fprintf(f,"#ifndef RSTRUCT_H\n#define RSTRUCT_H\n\n");
+
+	for ( size_t rx=0; rx<rpts.size(); ++rx ) {
+		const s_report& rpt = *rpts[rx];
+
+		fprintf(f,"//////////////////////////////////////////////////////////////////////\n");
+		if ( rpt.subid < 0 )
+			fprintf(f,"// Response %02X : %s\n",rpt.id,rpt.title.c_str());
+		else	fprintf(f,"// Response %02X %02X : %s\n",rpt.id,rpt.subid,rpt.title.c_str());
+		fprintf(f,"//////////////////////////////////////////////////////////////////////\n\n");
+		fprintf(f,"struct s_R%s {\n",suffix(rpt).c_str());
+
+		for ( size_t x=0; x<rpt.fields.size(); ++x ) {
+			const s_field& fld = rpt.fields[x];
+			const char *name = fld.name.c_str();
+
+			if ( is_sd(fld) ) {
+				fprintf(f,"\tunion {\t\t\t// %s\n",fld.desc.c_str());
+				fprintf(f,"\t  float  %s1;\n",name);
+				fprintf(f,"\t  double %s2;\n",name);
+				fprintf(f,"\t}\tu;\n");
+				continue;
+			}
+			if ( is_open(fld) ) {
+				fprintf(f,"\tuint16_t %s_len;\t// Bytes in %s[]\n",name,name);
+				fprintf(f,"\tuint8_t\t%s[%d];",name,open_max);
+			} else if ( fld.range )
+				fprintf(f,"\tuint8_t\t%s[%d];",name,fld.end - fld.start + 1);
+			else	fprintf(f,"\t%s\t%s;",types[fld.tx].ctype,name);
+			if ( !fld.desc.empty() )
+				fprintf(f,"\t// %s",fld.desc.c_str());
+			fputc('\n',f);
+		}
+		fprintf(f,"};\n\n");
+	}
+
+	fprintf(f,"#endif // RSTRUCT_H\n\n");
+	finish(f,"rstruct.h");
+}
+
+//////////////////////////////////////////////////////////////////////
+// rget.h
+//////////////////////////////////////////////////////////////////////
+
+static void
+gen_decls(const std::vector<const s_report *>& rpts) {
+	FILE *f = create("rget.h","RxPacket Decoder Declarations");
+
+	for ( size_t rx=0; rx<rpts.size(); ++rx )
+		fprintf(f,"\tbool get(s_R%s& recd);\n",suffix(*rpts[rx]).c_str());
+	fputc('\n',f);
+	finish(f,"rget.h");
+}
+
+//////////////////////////////////////////////////////////////////////
+// rdecode.cpp: one bounds check at the packet's offset (fixed(), as
+// in the hand written decoders), then loads at fixed offsets
+//////////////////////////////////////////////////////////////////////
+
+static void
+gen_decoders(const std::vector<const s_report *>& rpts,const bool super[256]) {
+	FILE *f = create("rdecode.cpp","RxPacket Decoders");
+	static const char *loads[] = {	// By e_type
+		"p[%d]", "int16_t(be16(p+%d))", "int32_t(be32(p+%d))",
+		"bef(p+%d)", "bed(p+%d)", 0
+	};
+
+	fprintf(f,
+		"#include <string.h>\n\n"
+		"#include \"tsip.hpp\"\n"
+		"#include \"layout.hpp\"\n\n"
+		"//////////////////////////////////////////////////////////////////////\n"
+		"// Each decoder reads at the packet's offset, as the hand written\n"
+		"// ones do: after id(), which also takes the sub id of an id in\n"
+		"// tsip_super[]. The offset is left after the last field.\n"
+		"//////////////////////////////////////////////////////////////////////\n\n");
+
+	for ( size_t rx=0; rx<rpts.size(); ++rx ) {
+		const s_report& rpt = *rpts[rx];
+		int minlen, maxlen, at;
+		int sub = super[rpt.id] ? 1 : 0;	// Bytes id() takes after the id
+		const s_field *var = 0;
+
+		lengths(rpt,minlen,maxlen);
+
+		for ( size_t x=0; x<rpt.fields.size(); ++x )
+			if ( is_open(rpt.fields[x]) || is_sd(rpt.fields[x]) )
+				var = &rpt.fields[x];
+
+		fprintf(f,"bool\nRxPacket::get(s_R%s& recd) {\n",suffix(rpt).c_str());
+		if ( !var )
+			fprintf(f,"\tconst uint8_t *p = fixed(%d);\n",minlen - 1 - sub);
+		else if ( is_sd(*var) )
+			fprintf(f,"\tconst uint8_t *p = fixed(%d,%d);\n",
+				var->start + 4 - sub,var->start + 8 - sub);
+		else	fprintf(f,"\tconst uint8_t *p = fixed(%d);\n",var->start - sub);
+
+		// A first field id() took as a sub id is read from p[-1]
+		if ( sub && rpt.subid < 0 && !rpt.fields.empty() && rpt.fields[0].start == 0 )
+			fprintf(f,"\n\tif ( !p || p < buf + 2 )\n\t\treturn false;\n");
+		else	fprintf(f,"\n\tif ( !p )\n\t\treturn false;\n");
+
+		for ( size_t x=0; x<rpt.fields.size(); ++x ) {
+			const s_field& fld = rpt.fields[x];
+			const char *name = fld.name.c_str();
+
+			if ( &fld == var )
+				continue;
+			at = fld.start - sub;
+			if ( fld.range ) {
+				fprintf(f,"\tmemcpy(recd.%s,p+%d,%d);\n",name,at,fld.end-fld.start+1);
+				continue;
+			}
+			fprintf(f,"\trecd.%s = ",name);
+			fprintf(f,loads[types[fld.tx].type],at);
+			fprintf(f,at < 0 ? ";\t// Taken by id() as a sub id\n" : ";\n");
+		}
+
+		if ( var && is_sd(*var) ) {
+			const char *name = var->name.c_str();
+
+			fprintf(f,"\tif ( state_sd )\n");
+			fprintf(f,"\t\trecd.u.%s2 = bed(p+%d);\n",name,var->start - sub);
+			fprintf(f,"\telse\trecd.u.%s1 = bef(p+%d);\n",name,var->start - sub);
+		} else if ( var ) {
+			const char *name = var->name.c_str();
+
+			fprintf(f,"\trecd.%s_len = get(recd.%s,sizeof recd.%s);\n",name,name,name);
+		}
+		fprintf(f,"\treturn true;\n}\n\n");
+	}
+	finish(f,"rdecode.cpp");
+}
+
+//////////////////////////////////////////////////////////////////////
+// rlength.h: rows of tsiplen.cpp's rules[], sorted by id and sub id
+//////////////////////////////////////////////////////////////////////
+
+static bool
+by_id(const s_report *a,const s_report *b) {
+	if ( a->id != b->id )
+		return a->id < b->id;
+	return a->subid < b->subid;
+}
+
+static void
+gen_lengths(const std::vector<s_report>& reports) {
+	FILE *f = create("rlength.h","Report Length Rules");
+	std::vector<const s_report *> sorted;
+	int minlen, maxlen;
+
+	for ( size_t x=0; x<reports.size(); ++x )
+		sorted.push_back(&reports[x]);
+	std::stable_sort(sorted.begin(),sorted.end(),by_id);
+
+	for ( size_t x=0; x<sorted.size(); ++x ) {
+		const s_report& rpt = *sorted[x];
+
+		lengths(rpt,minlen,maxlen);
+		if ( rpt.subid < 0 )
+			fprintf(f,"\t{ 0x%02X, -1,\t%d,\t%d },",rpt.id,minlen,maxlen);
+		else	fprintf(f,"\t{ 0x%02X, 0x%02X,\t%d,\t%d },",rpt.id,rpt.subid,minlen,maxlen);
+		fprintf(f,"\t// %s%s\n",rpt.title.c_str(),rpt.note.c_str());
+	}
+	fputc('\n',f);
+	finish(f,"rlength.h");
+}
+
+//////////////////////////////////////////////////////////////////////
+// Ids whose reports have a sub id (in msgs.dat or by hand in
+// tsip.hpp): id() takes the byte after these as a sub id
+//////////////////////////////////////////////////////////////////////
+
+static void
+find_super(const std::vector<s_report>& reports,const std::set<std::string>& hand,bool super[256]) {
+
+	for ( int x=0; x<256; ++x )
+		super[x] = false;
+	for ( size_t x=0; x<reports.size(); ++x )
+		if ( reports[x].subid >= 0 )
+			super[reports[x].id] = true;
+	for ( std::set<std::string>::const_iterator it=hand.begin(); it != hand.end(); ++it )
+		if ( it->size() == 4 )
+			super[strtoul(it->substr(0,2).c_str(),0,16)] = true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// rlist.h: the generated decoders as an X-list, full id as id()
+// returns it (id << 8 | sub id for super packets)
+//////////////////////////////////////////////////////////////////////
+
+static void
+gen_list(const std::vector<const s_report *>& rpts) {
+	FILE *f = create("rlist.h","Generated Reports as an X-List");
+
+	fprintf(f,"#define TSIP_GENERATED(X)");
+	for ( size_t rx=0; rx<rpts.size(); ++rx ) {
+		const s_report& rpt = *rpts[rx];
+		int full = rpt.subid < 0 ? rpt.id : rpt.id << 8 | rpt.subid;
+
+		fprintf(f,"\t\\\n\tX(0x%02X,s_R%s)",full,suffix(rpt).c_str());
+	}
+	fprintf(f,"\n\n");
+	finish(f,"rlist.h");
+}
+
+//////////////////////////////////////////////////////////////////////
+// rsuper.h: rows of tsip.cpp's tsip_super[]
+//////////////////////////////////////////////////////////////////////
+
+static void
+gen_super(const bool super[256]) {
+	FILE *f = create("rsuper.h","Ids With Sub Ids");
+
+	for ( int row=0; row<256; row += 16 ) {
+		fputc('\t',f);
+		for ( int x=row; x<row+16; ++x )
+			fprintf(f,"%d,%s",super[x],x < row+15 ? " " : "");
+		fprintf(f,"\t// %02X-%02X\n",row,row+15);
+	}
+	fputc('\n',f);
+	finish(f,"rsuper.h");
+}
+
+int
+main(int argc,char **argv) {
+	std::vector<s_report> reports;
+	std::vector<const s_report *> gen;
+	std::set<std::string> hand;
+	bool super[256];
+
+	if ( argc != 3 ) {
+		fprintf(stderr,"Usage: %s msgs.dat tsip.hpp\n",argv[0]);
+		return 2;
+	}
+
+	load(argv[1],reports);
+	hand_written(argv[2],hand);
+	find_super(reports,hand,super);
+
+	for ( size_t x=0; x<reports.size(); ++x ) {
+		const s_report& rpt = reports[x];
+
+		if ( hand.count(suffix(rpt)) )
+			continue;
+		if ( !decodable(rpt) ) {
+			fprintf(stderr,"%s: report %s skipped: fields after a variable field\n",
+				argv[1],suffix(rpt).c_str());
+			continue;
+		}
+		gen.push_back(&rpt);
+	}
+
+	gen_structs(gen);
+	gen_decls(gen);
+	gen_decoders(gen,super);
+	gen_lengths(reports);
+	gen_super(super);
+	gen_list(gen);
+	return 0;
+}
+
+// End rgen.cpp
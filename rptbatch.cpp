@@ -0,0 +1,199 @@
+//////////////////////////////////////////////////////////////////////
+// rptbatch.cpp -- Batch Decoding of Fix Reports into Columns
+// Date: Sun Oct 18 23:57:40 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include "tsip.hpp"
+#include "layout.hpp"
+#include "rptbatch.hpp"
+
+static const unsigned prefetch_ahead = 8;	// Packets
+
+static const unsigned sv_max = sizeof ((s_R6D *)0)->sv_prn;
+
+//////////////////////////////////////////////////////////////////////
+// Stands in for a short packet's record: big enough for any id
+// decoded here, zeroed so the discarded row is harmless
+//////////////////////////////////////////////////////////////////////
+
+static const uint8_t dummy_record[64] = { 0 };
+
+RptBatch::RptBatch() {
+	slab = 0;
+	capacity = 0;
+	state_sd = false;
+	memset(&c84,0,sizeof c84);
+	memset(&c56,0,sizeof c56);
+	memset(&c6D,0,sizeof c6D);
+	memset(&c5A,0,sizeof c5A);
+	clear();
+}
+
+RptBatch::~RptBatch() {
+	delete[] slab;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Allocate room for rows reports of each id, all columns carved from
+// one slab (widest types first, to keep each column aligned)
+//////////////////////////////////////////////////////////////////////
+
+void
+RptBatch::open(unsigned rows) {
+	double *dp;
+	float *fp;
+	uint8_t *bp;
+
+	delete[] slab;
+	capacity = rows;
+	slab = new double[rows * 7 + (rows * (12 * sizeof(float) + sizeof(uint32_t) + 3 + sv_max) + 7) / 8];
+
+	dp = slab;
+	c84.latitude = dp;	dp += rows;
+	c84.longitude = dp;	dp += rows;
+	c84.altitude = dp;	dp += rows;
+	c84.clock_bias = dp;	dp += rows;
+	c84.time_of_fix = dp;	dp += rows;
+	c56.time_of_fix = dp;	dp += rows;
+	c5A.time = dp;		dp += rows;
+
+	fp = (float *)dp;
+	c56.eastvel = fp;	fp += rows;
+	c56.northvel = fp;	fp += rows;
+	c56.upvel = fp;		fp += rows;
+	c56.clock_bias_rate = fp; fp += rows;
+	c6D.pdop = fp;		fp += rows;
+	c6D.hdop = fp;		fp += rows;
+	c6D.vdop = fp;		fp += rows;
+	c6D.tdop = fp;		fp += rows;
+	c5A.samplength = fp;	fp += rows;
+	c5A.siglevel = fp;	fp += rows;
+	c5A.code_phase = fp;	fp += rows;
+	c5A.doppler = fp;	fp += rows;
+	c6D.sv_first = (uint32_t *)fp;
+
+	bp = (uint8_t *)(c6D.sv_first + rows);
+	c6D.fixmode = bp;	bp += rows;
+	c6D.nsv = bp;		bp += rows;
+	c5A.sv_prn = bp;	bp += rows;
+	c6D.sv_prn = bp;
+
+	clear();
+}
+
+void
+RptBatch::clear() {
+	n84 = n56 = n6D = n5A = 0;
+	nsv = 0;
+	skipped = rejected = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Decode n packets, appending to the columns
+//
+// Each packet costs one switch on its id. Inside a case the record
+// pointer is picked without a branch (the packet, or dummy_record if
+// it is too short), every field is loaded and stored at the next row,
+// and the row count then advances by ok (0 or 1).
+//
+// RETURNS:
+//	Packets consumed: n, or fewer when a column set filled up
+//	(clear() and call again with the rest)
+//////////////////////////////////////////////////////////////////////
+
+unsigned
+RptBatch::decode(const s_pktref *pkts,unsigned n) {
+	typedef Layout<s_R84> L84;
+	typedef Layout<s_R56> L56;
+	typedef Layout<s_R6D> L6D;
+	typedef Layout<s_R5A> L5A;
+	const unsigned need84 = state_sd ? L84::size_sd : L84::size;
+	const unsigned need56 = state_sd ? L56::size_sd : L56::size;
+	unsigned x;
+
+	for ( x=0; x<n; ++x ) {
+		if ( x + prefetch_ahead < n )
+			__builtin_prefetch(pkts[x+prefetch_ahead].data);
+
+		if ( pkts[x].length <= 0 ) {
+			++rejected;
+			continue;
+		}
+
+		const uint8_t *pkt = pkts[x].data;
+		const unsigned len = pkts[x].length - 1;	// After the id
+		const uint8_t *p;
+		unsigned ok, r;
+
+		switch ( pkt[0] ) {
+		case 0x84 :
+			if ( (r = n84) >= capacity )
+				return x;
+			ok = len >= need84;
+			p = ok ? pkt + 1 : dummy_record;
+			c84.latitude[r] = L84::latitude::load(p);
+			c84.longitude[r] = L84::longitude::load(p);
+			c84.altitude[r] = L84::altitude::load(p);
+			c84.clock_bias[r] = L84::clock_bias::load(p);
+			c84.time_of_fix[r] = state_sd ? L84::time_of_fix2::load(p) : L84::time_of_fix1::load(p);
+			n84 += ok;
+			break;
+		case 0x56 :
+			if ( (r = n56) >= capacity )
+				return x;
+			ok = len >= need56;
+			p = ok ? pkt + 1 : dummy_record;
+			c56.eastvel[r] = L56::eastvel::load(p);
+			c56.northvel[r] = L56::northvel::load(p);
+			c56.upvel[r] = L56::upvel::load(p);
+			c56.clock_bias_rate[r] = L56::clock_bias_rate::load(p);
+			c56.time_of_fix[r] = state_sd ? L56::time_of_fix2::load(p) : L56::time_of_fix1::load(p);
+			n56 += ok;
+			break;
+		case 0x6D :
+			if ( (r = n6D) >= capacity )
+				return x;
+			{
+				unsigned nv;
+
+				ok = len >= L6D::size;
+				p = ok ? pkt + 1 : dummy_record;
+				nv = ok ? len - L6D::size : 0;
+				nv = nv < sv_max ? nv : sv_max;
+				c6D.fixmode[r] = L6D::fixmode::load(p);
+				c6D.pdop[r] = L6D::pdop::load(p);
+				c6D.hdop[r] = L6D::hdop::load(p);
+				c6D.vdop[r] = L6D::vdop::load(p);
+				c6D.tdop[r] = L6D::tdop::load(p);
+				c6D.nsv[r] = nv;
+				c6D.sv_first[r] = nsv;
+				memcpy(c6D.sv_prn + nsv,p + L6D::size,nv);
+				nsv += nv;
+			}
+			n6D += ok;
+			break;
+		case 0x5A :
+			if ( (r = n5A) >= capacity )
+				return x;
+			ok = len >= L5A::size;
+			p = ok ? pkt + 1 : dummy_record;
+			c5A.sv_prn[r] = L5A::sv_prn::load(p);
+			c5A.samplength[r] = L5A::samplength::load(p);
+			c5A.siglevel[r] = L5A::siglevel::load(p);
+			c5A.code_phase[r] = L5A::code_phase::load(p);
+			c5A.doppler[r] = L5A::doppler::load(p);
+			c5A.time[r] = L5A::time::load(p);
+			n5A += ok;
+			break;
+		default :
+			++skipped;
+			continue;
+		}
+		rejected += !ok;
+	}
+	return x;
+}
+
+// End rptbatch.cpp
@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////
+// rptbatch.hpp -- Batch Decoding of Fix Reports into Columns
+// Date: Sun Oct 18 23:57:40 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef RPTBATCH_HPP
+#define RPTBATCH_HPP
+
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////////
+// One framed (unstuffed) packet, id first
+//////////////////////////////////////////////////////////////////////
+
+struct s_pktref {
+	const uint8_t	*data;
+	int		length;
+};
+
+//////////////////////////////////////////////////////////////////////
+// Column sets: element r of every array belongs to the r'th report
+// of that id. Times of fix are doubles whatever the precision.
+//////////////////////////////////////////////////////////////////////
+
+struct s_cols84 {			// Double precision LLA fix
+	double	*latitude;
+	double	*longitude;
+	double	*altitude;
+	double	*clock_bias;
+	double	*time_of_fix;
+};
+
+struct s_cols56 {			// ENU velocity fix
+	float	*eastvel;
+	float	*northvel;
+	float	*upvel;
+	float	*clock_bias_rate;
+	double	*time_of_fix;
+};
+
+struct s_cols6D {			// All in view satellite selection
+	uint8_t	*fixmode;
+	float	*pdop;
+	float	*hdop;
+	float	*vdop;
+	float	*tdop;
+	uint8_t	*nsv;			// Satellites in this report..
+	uint32_t *sv_first;		// ..at sv_prn[sv_first[r]]
+	uint8_t	*sv_prn;		// All reports' PRNs, back to back
+};
+
+struct s_cols5A {			// Raw measurement data
+	uint8_t	*sv_prn;
+	float	*samplength;
+	float	*siglevel;
+	float	*code_phase;
+	float	*doppler;
+	double	*time;
+};
+
+//////////////////////////////////////////////////////////////////////
+// Decode a span of packets in one pass, appending each 84, 56, 6D
+// and 5A report to its columns; other ids are skipped. The loop
+// prefetches packets ahead, and a short packet reads a zeroed dummy
+// record and is not counted, rather than taking a branch per field.
+// Column space is allocated once by open().
+//////////////////////////////////////////////////////////////////////
+
+class RptBatch {
+	double	*slab;		// All columns
+	unsigned capacity;	// Rows per column set
+	bool	state_sd;	// Double precision time of fix
+
+	s_cols84 c84;
+	s_cols56 c56;
+	s_cols6D c6D;
+	s_cols5A c5A;
+	unsigned n84, n56, n6D, n5A; // Rows filled
+	unsigned nsv;		// sv_prn[] bytes filled
+
+	unsigned long skipped;	// Packets of other ids
+	unsigned long rejected;	// Packets too short for their id
+
+	// No copies: columns are owned
+	RptBatch(const RptBatch&) = delete;
+	RptBatch& operator=(const RptBatch&) = delete;
+
+public:	RptBatch();
+	~RptBatch();
+
+	void open(unsigned rows);		// Rows per id
+	void clear();				// Empty the columns
+	inline void set_precision(bool dprecision) { state_sd = dprecision; }
+
+	unsigned decode(const s_pktref *pkts,unsigned n);
+
+	inline const s_cols84& cols84() const { return c84; }
+	inline const s_cols56& cols56() const { return c56; }
+	inline const s_cols6D& cols6D() const { return c6D; }
+	inline const s_cols5A& cols5A() const { return c5A; }
+	inline unsigned rows84() const { return n84; }
+	inline unsigned rows56() const { return n56; }
+	inline unsigned rows6D() const { return n6D; }
+	inline unsigned rows5A() const { return n5A; }
+
+	inline unsigned long others() const { return skipped; }
+	inline unsigned long short_packets() const { return rejected; }
+};
+
+#endif // RPTBATCH_HPP
+
+// End rptbatch.hpp
@@ -0,0 +1,104 @@
+//////////////////////////////////////////////////////////////////////
+// rptdisp.cpp -- Report Handler Registry Keyed by Full TSIP Id
+// Date: Sun Oct 18 23:21:05 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include "rptdisp.hpp"
+
+RptDispatch::RptDispatch() {
+	memset(top,0,sizeof top);
+	memset(sub,0,sizeof sub);
+	handled = rejected = 0;
+}
+
+RptDispatch::~RptDispatch() {
+	for ( int x=0; x<256; ++x )
+		delete[] sub[x];
+}
+
+//////////////////////////////////////////////////////////////////////
+// Handler slot for a full id
+//
+// RETURNS:
+//	Slot, or 0 if id is not of its id's form (a plain id given
+//	for a super packet, or a sub id for a plain one), or if the
+//	sub table does not exist and create is false
+//////////////////////////////////////////////////////////////////////
+
+RptDispatch::s_handler *
+RptDispatch::slot(uint16_t id,bool create) {
+	uint8_t hi = id >> 8;
+
+	if ( !hi )
+		return tsip_super[id] ? 0 : &top[id];
+	if ( !tsip_super[hi] )
+		return 0;
+	if ( !sub[hi] ) {
+		if ( !create )
+			return 0;
+		sub[hi] = new s_handler[256];
+		memset(sub[hi],0,256 * sizeof(s_handler));
+	}
+	return &sub[hi][id & 0xFF];
+}
+
+bool
+RptDispatch::add(uint16_t id,rptcb_t cb,void *arg) {
+	s_handler *h = slot(id,true);
+
+	if ( !h )
+		return false;
+	h->cb = cb;
+	h->arg = arg;
+	return true;
+}
+
+void
+RptDispatch::remove(uint16_t id) {
+	s_handler *h = slot(id,false);
+
+	if ( h )
+		h->cb = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pass the report in rxpkt (just loaded) to its handler
+//
+// RETURNS:
+//	true	- Handler called
+//	false	- No handler for the id, or the packet is too short
+//		  to hold it
+//////////////////////////////////////////////////////////////////////
+
+bool
+RptDispatch::dispatch(RxPacket& rxpkt) {
+	const s_handler *h;
+	uint8_t id, subid;
+
+	if ( !rxpkt.get(id) ) {
+		++rejected;
+		return false;
+	}
+	if ( !tsip_super[id] ) {
+		h = &top[id];
+		if ( !h->cb ) {
+			++rejected;
+			return false;
+		}
+		++handled;
+		h->cb(rxpkt,id,h->arg);
+		return true;
+	}
+
+	if ( !sub[id] || !rxpkt.get(subid) || !(h = &sub[id][subid])->cb ) {
+		++rejected;
+		return false;
+	}
+	++handled;
+	h->cb(rxpkt,(uint16_t(id) << 8) | subid,h->arg);
+	return true;
+}
+
+// End rptdisp.cpp
@@ -0,0 +1,61 @@
+//////////////////////////////////////////////////////////////////////
+// rptdisp.hpp -- Report Handler Registry Keyed by Full TSIP Id
+// Date: Sun Oct 18 23:17:44 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef RPTDISP_HPP
+#define RPTDISP_HPP
+
+#include <stdint.h>
+
+#include "tsip.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Handler for one report. rxpkt is positioned after the id (and sub
+// id), ready for rxpkt.get(s_Rxx&), and id is the full id: 0x84, or
+// (id << 8) | sub id for super packets (0x8FAB).
+//////////////////////////////////////////////////////////////////////
+
+typedef void (*rptcb_t)(RxPacket& rxpkt,uint16_t id,void *arg);
+
+//////////////////////////////////////////////////////////////////////
+// Flat handler tables: one slot per first byte, and for super
+// packets (tsip_super[]) a 256 slot sub table, allocated when the
+// first handler for that id is added. dispatch() classifies and
+// finds the handler with one or two indexed loads; a report with no
+// handler is rejected after reading one byte, or two for a super
+// packet that has a sub table.
+//////////////////////////////////////////////////////////////////////
+
+class RptDispatch {
+	struct s_handler {
+		rptcb_t		cb;		// Handler, or 0
+		void		*arg;
+	};
+
+	s_handler top[256];	// By id (not super packets)
+	s_handler *sub[256];	// Per super packet id: by sub id (or 0)
+	unsigned long handled;	// Reports passed to a handler
+	unsigned long rejected;	// Reports with no handler (or empty)
+
+	// No copies: sub tables are owned
+	RptDispatch(const RptDispatch&) = delete;
+	RptDispatch& operator=(const RptDispatch&) = delete;
+
+protected:
+	s_handler *slot(uint16_t id,bool create);
+
+public:	RptDispatch();
+	~RptDispatch();
+
+	bool add(uint16_t id,rptcb_t cb,void *arg=0);	// False if id is wrong form
+	void remove(uint16_t id);
+	bool dispatch(RxPacket& rxpkt);			// Load()ed packet
+
+	inline unsigned long dispatched() const { return handled; }
+	inline unsigned long unhandled() const { return rejected; }
+};
+
+#endif // RPTDISP_HPP
+
+// End rptdisp.hpp
@@ -0,0 +1,340 @@
+//////////////////////////////////////////////////////////////////////
+// rxthread.cpp -- Receiver Thread Feeding an SPSC Packet Ring
+// Date: Sun Oct 18 19:41:55 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <assert.h>
+
+#include "rxthread.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Non-blocking, close on exec pipe
+//////////////////////////////////////////////////////////////////////
+
+static bool
+mkpipe(int fds[2]) {
+
+	if ( pipe(fds) )
+		return false;
+	for ( int x=0; x<2; ++x ) {
+		fcntl(fds[x],F_SETFL,fcntl(fds[x],F_GETFL) | O_NONBLOCK);
+		fcntl(fds[x],F_SETFD,FD_CLOEXEC);
+	}
+	return true;
+}
+
+static void
+drain(int fd) {
+	char buf[64];
+	ssize_t rc;
+
+	do	rc = read(fd,buf,sizeof buf);
+	while ( rc > 0 || (rc < 0 && errno == EINTR) );
+}
+
+//////////////////////////////////////////////////////////////////////
+// Make a wakeup pipe readable. EAGAIN (the pipe is full) means it
+// already is, so only EINTR needs another try.
+//////////////////////////////////////////////////////////////////////
+
+static void
+wake(int fd) {
+
+	while ( write(fd,"",1) < 0 && errno == EINTR )
+		;
+}
+
+RxThread::RxThread() : stopping(false), eof(false), sleeping(false),
+  full(false), packets(0), overruns(0), overrun_bytes(0), high_water(0),
+  full_waits(0) {
+	pkt = 0;
+	slab = 0;
+	maxlen = 0;
+	lossless = false;
+	stop_pipe[0] = stop_pipe[1] = -1;
+	wake_pipe[0] = wake_pipe[1] = -1;
+	room_pipe[0] = room_pipe[1] = -1;
+	batches = 0;
+	taken = 0;
+}
+
+RxThread::~RxThread() {
+
+	stop();
+	for ( int x=0; x<2; ++x ) {
+		if ( stop_pipe[x] >= 0 )
+			close(stop_pipe[x]);
+		if ( wake_pipe[x] >= 0 )
+			close(wake_pipe[x]);
+		if ( room_pipe[x] >= 0 )
+			close(room_pipe[x]);
+	}
+	delete[] slab;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Start the reader on an opened Packet. nslots (a power of 2) is the
+// ring size; packets longer than maxlen are cut to maxlen and marked
+// not ended.
+//
+// RETURNS:
+//	true	- Reader running
+//	false	- Already started, or no pipes (see errno)
+//////////////////////////////////////////////////////////////////////
+
+bool
+RxThread::start(Packet& pkt,unsigned nslots,int maxlen) {
+
+	assert(maxlen > 0);
+	if ( this->pkt )
+		return false;
+	if ( stop_pipe[0] < 0 && !mkpipe(stop_pipe) )
+		return false;
+	if ( wake_pipe[0] < 0 && !mkpipe(wake_pipe) )
+		return false;
+	if ( room_pipe[0] < 0 && !mkpipe(room_pipe) )
+		return false;
+
+	this->pkt = &pkt;
+	this->maxlen = maxlen;
+	lossless = strcmp(pkt.get_transport().kind(),"tty") != 0
+		&& strcmp(pkt.get_transport().kind(),"pty") != 0;
+	ring.open(nslots);
+	delete[] slab;
+	slab = new uint8_t[size_t(nslots) * maxlen];
+	for ( unsigned x=0; x<nslots; ++x ) {
+		s_rxslot& slot = ring.slot(x);
+
+		slot.data = slab + size_t(x) * maxlen;
+		slot.length = 0;
+		slot.ended = false;
+	}
+
+	stopping = false;
+	eof = false;
+	reader = std::thread(&RxThread::run,this);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Stop the reader (if running) and wait for it to exit. Packets
+// still in the ring remain available to take().
+//////////////////////////////////////////////////////////////////////
+
+void
+RxThread::stop() {
+
+	if ( !reader.joinable() )
+		return;
+	stopping = true;
+	wake(stop_pipe[1]);
+	reader.join();
+	drain(stop_pipe[0]);
+	pkt = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Framer callback (reader thread): copy the packet into the next
+// free slot. With none free, wait for one (lossless) or count an
+// overrun.
+//////////////////////////////////////////////////////////////////////
+
+void
+RxThread::enqueue(void *arg,uint8_t *packet,int length,bool ended) {
+	RxThread& rx = *(RxThread *)arg;
+	s_rxslot *slot = rx.ring.claim();
+	unsigned depth;
+
+	if ( !slot && rx.lossless ) {
+		rx.full_waits.fetch_add(1,std::memory_order_relaxed);
+		rx.notify();
+		slot = rx.await_slot();
+	}
+	if ( !slot ) {
+		rx.overruns.fetch_add(1,std::memory_order_relaxed);
+		rx.overrun_bytes.fetch_add(length,std::memory_order_relaxed);
+		return;
+	}
+
+	if ( length > rx.maxlen ) {
+		length = rx.maxlen;
+		ended = false;
+	}
+	memcpy(slot->data,packet,length);
+	slot->length = length;
+	slot->ended = ended;
+	slot->stamp = rx.pkt->stamp();
+	rx.ring.publish();
+
+	rx.packets.fetch_add(1,std::memory_order_relaxed);
+	depth = rx.ring.depth();
+	if ( depth > rx.high_water.load(std::memory_order_relaxed) )
+		rx.high_water.store(depth,std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Reader, ring full: sleep until release() frees a slot or stop().
+// The mirror of wait(): the fence pairs with the one in release(),
+// so either we see the slot or release() sees us waiting.
+//
+// RETURNS:
+//	Free slot, or 0 when stopping
+//////////////////////////////////////////////////////////////////////
+
+RxThread::s_rxslot *
+RxThread::await_slot() {
+	struct pollfd fds[2];
+	s_rxslot *slot;
+
+	fds[0].fd = room_pipe[0];
+	fds[0].events = POLLIN;
+	fds[1].fd = stop_pipe[0];
+	fds[1].events = POLLIN;
+
+	while ( !(slot = ring.claim()) && !stopping.load(std::memory_order_relaxed) ) {
+		full.store(true,std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if ( (slot = ring.claim()) ) {
+			full.store(false,std::memory_order_relaxed);
+			break;
+		}
+		fds[0].revents = fds[1].revents = 0;
+		poll(fds,2,-1);			// EINTR: just look again
+		full.store(false,std::memory_order_relaxed);
+		drain(room_pipe[0]);
+	}
+	return slot;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Consumer: hand n slots back, waking the reader if it is waiting
+// for room
+//////////////////////////////////////////////////////////////////////
+
+void
+RxThread::release(unsigned n) {
+
+	ring.release(n);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if ( full.load(std::memory_order_relaxed) && full.exchange(false) )
+		wake(room_pipe[1]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Wake the consumer if it is sleeping in wait(). The fence pairs
+// with the one in wait(): either the consumer sees the new packets
+// or we see it sleeping.
+//////////////////////////////////////////////////////////////////////
+
+void
+RxThread::notify() {
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if ( sleeping.load(std::memory_order_relaxed) && sleeping.exchange(false) )
+		wake(wake_pipe[1]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Reader thread: read and frame until EOF or stop(). The consumer is
+// woken once per read, however many packets it completed.
+//////////////////////////////////////////////////////////////////////
+
+void
+RxThread::run() {
+	struct pollfd fds[3];
+	bool pollable = pkt->get_transport().pollable();
+	int nfds = pkt->cancel() >= 0 ? 3 : 2;
+	int ms, rc;
+
+	fds[0].fd = pkt->fd();
+	fds[0].events = POLLIN;
+	fds[1].fd = stop_pipe[0];
+	fds[1].events = POLLIN;
+	fds[2].fd = pkt->cancel();
+	fds[2].events = POLLIN;
+
+	while ( !stopping.load(std::memory_order_relaxed) ) {
+		if ( pollable ) {
+			ms = pkt->gap_left();
+			fds[0].revents = fds[1].revents = fds[2].revents = 0;
+			rc = poll(fds,nfds,ms);
+			if ( rc < 0 ) {
+				if ( errno == EINTR )
+					continue;
+				break;
+			}
+			if ( fds[1].revents || fds[2].revents )
+				break;			// stop(), or cancelled
+			if ( !(fds[0].revents & (POLLIN|POLLHUP|POLLERR)) ) {
+				if ( pkt->expire(enqueue,this) )
+					notify();
+				continue;
+			}
+		}
+		if ( pkt->pump(enqueue,this) < 0 )
+			break;
+		notify();
+	}
+
+	eof.store(true,std::memory_order_release);
+	notify();
+}
+
+//////////////////////////////////////////////////////////////////////
+// Consumer: wait up to ms (-1 = forever) for packets
+//
+// RETURNS:
+//	1	- Packets ready for take()
+//	0	- Timed out
+//	-1	- Reader has stopped and the ring is empty
+//////////////////////////////////////////////////////////////////////
+
+int
+RxThread::wait(int ms) {
+	struct pollfd pfd;
+	int rc;
+
+	for (;;) {
+		if ( ring.depth() > 0 )
+			return 1;
+		if ( eof.load(std::memory_order_acquire) )
+			return ring.depth() > 0 ? 1 : -1;
+
+		sleeping.store(true,std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if ( ring.depth() > 0 || eof.load(std::memory_order_acquire) ) {
+			sleeping.store(false,std::memory_order_relaxed);
+			continue;
+		}
+
+		pfd.fd = wake_pipe[0];
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		rc = poll(&pfd,1,ms);
+		sleeping.store(false,std::memory_order_relaxed);
+		drain(wake_pipe[0]);
+		if ( rc == 0 )
+			return ring.depth() > 0 ? 1 : 0;
+	}
+}
+
+s_rxstats
+RxThread::stats() const {
+	s_rxstats st;
+
+	st.packets = packets.load(std::memory_order_relaxed);
+	st.overruns = overruns.load(std::memory_order_relaxed);
+	st.overrun_bytes = overrun_bytes.load(std::memory_order_relaxed);
+	st.high_water = high_water.load(std::memory_order_relaxed);
+	st.full_waits = full_waits.load(std::memory_order_relaxed);
+	st.batches = batches;
+	st.taken = taken;
+	return st;
+}
+
+// End rxthread.cpp
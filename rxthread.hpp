@@ -0,0 +1,105 @@
+//////////////////////////////////////////////////////////////////////
+// rxthread.hpp -- Receiver Thread Feeding an SPSC Packet Ring
+// Date: Sun Oct 18 19:34:12 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef RXTHREAD_HPP
+#define RXTHREAD_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+
+#include "ttyio.hpp"
+#include "spscring.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Reader thread statistics. From a serial port (tty or pty) a
+// packet arriving to a full ring is dropped and counted as an
+// overrun: the reader never waits for the consumer, so the port is
+// always drained. Other sources (files, pipes, sockets) can be
+// paused, so there the reader waits for a free slot instead.
+//////////////////////////////////////////////////////////////////////
+
+struct s_rxstats {
+	unsigned long	packets;	// Packets put into the ring
+	unsigned long	overruns;	// Packets dropped: ring full
+	unsigned long	overrun_bytes;	// Bytes in those packets
+	unsigned long	full_waits;	// Times the reader waited for a slot
+	unsigned	high_water;	// Most slots ever in use
+	unsigned long	batches;	// Non-empty take() calls
+	unsigned long	taken;		// Packets returned by take()
+};
+
+//////////////////////////////////////////////////////////////////////
+// One thread owns an opened Packet: it polls the fd, frames, and
+// copies each packet with its arrival stamp into a ring slot. One
+// consumer thread drains the ring in batches with take() and
+// release(), waiting with wait() when it is empty. While running,
+// nothing else may receive from the Packet; sending with put() from
+// another thread is fine (see ttyio.hpp). The Packet's cancel fd
+// ends the reader as at EOF.
+//////////////////////////////////////////////////////////////////////
+
+class RxThread {
+public:	struct s_rxslot {
+		uint8_t		*data;		// Packet bytes (slot's own)
+		int		length;		// Packet length
+		bool		ended;		// True if ended by DLE ETX
+		s_pktstamp	stamp;		// Arrival times
+	};
+
+private:
+	Packet	*pkt;		// Receiver (owned by the thread while running)
+	SpscRing<s_rxslot> ring; // Packets for the consumer
+	uint8_t	*slab;		// Slot data, maxlen bytes per slot
+	int	maxlen;		// Largest packet kept
+	bool	lossless;	// Wait for a free slot rather than drop
+
+	std::thread reader;	// Reader thread
+	std::atomic<bool> stopping; // stop() called
+	std::atomic<bool> eof;	// Reader saw EOF and exited
+	std::atomic<bool> sleeping; // Consumer is in wait()
+	std::atomic<bool> full;	// Reader is waiting for a free slot
+	int	stop_pipe[2];	// Wakes the reader for stop()
+	int	wake_pipe[2];	// Wakes the consumer
+	int	room_pipe[2];	// Wakes the reader when slots are freed
+
+	std::atomic<unsigned long> packets;	// Producer side counters
+	std::atomic<unsigned long> overruns;
+	std::atomic<unsigned long> overrun_bytes;
+	std::atomic<unsigned> high_water;
+	std::atomic<unsigned long> full_waits;
+	unsigned long batches;			// Consumer side counters
+	unsigned long taken;
+
+protected:
+	static void enqueue(void *arg,uint8_t *packet,int length,bool ended);
+	void run();				// Reader thread body
+	void notify();				// Wake a waiting consumer
+	s_rxslot *await_slot();			// Wait for a free slot (lossless)
+
+public:	RxThread();
+	~RxThread();
+
+	bool start(Packet& pkt,unsigned nslots=256,int maxlen=1024);
+	void stop();				// Stop and join the reader
+
+	int wait(int ms=-1);			// 1 ready, 0 timeout, -1 EOF
+	inline unsigned take(s_rxslot **first) { // Batch of ready slots
+		unsigned n = ring.peek(first);
+
+		if ( n ) {
+			++batches;
+			taken += n;
+		}
+		return n;
+	}
+	void release(unsigned n);		// Done with n taken slots
+
+	s_rxstats stats() const;
+};
+
+#endif // RXTHREAD_HPP
+
+// End rxthread.hpp
@@ -0,0 +1,135 @@
+//////////////////////////////////////////////////////////////////////
+// rxview.hpp -- Zero Copy Views of Received Reports
+// Date: Sun Oct 18 22:51:09 2026
+///////////////////////////////////////////////////////////////////////
+//
+// An RxView<s_Rxx> checks the packet length once, when constructed,
+// and then decodes a field only when its accessor is called, straight
+// from the packet bytes. Nothing is copied, so a consumer wanting one
+// field of a report pays for one load:
+//
+//	RxView<s_R84> fix(rxpkt);
+//
+//	if ( fix.valid() && fix.altitude() > ceiling )
+//		...
+//
+// Like get(), the view starts at the packet's offset (after id()) and
+// moves it past the fixed part of the report, which must be present
+// in full (else valid() is false). The view points into the packet
+// buffer, so it is good until the buffer is reused. Any report with
+// a Layout has get<field>(); the ones below also have named accessors.
+//////////////////////////////////////////////////////////////////////
+
+#ifndef RXVIEW_HPP
+#define RXVIEW_HPP
+
+#include <stdint.h>
+
+#include "tsip.hpp"
+#include "layout.hpp"
+
+template <class R>
+class RxRecord {
+public:	typedef Layout<R> L;
+
+protected:
+	const uint8_t *p;	// Record bytes, or 0 if the packet is too short
+	unsigned avail;		// Bytes from p to the end of the packet
+	bool	sd;		// Double precision time of fix
+
+public:	explicit RxRecord(RxPacket& pkt) {
+		avail = pkt.offset < pkt.length ? pkt.length - pkt.offset : 0;
+		sd = pkt.state_sd;
+		p = pkt.fixed(L::size,layout_size_sd<L>(0));
+	}
+
+	inline bool valid() const { return p != 0; }
+	inline bool is_double() const { return sd; }
+	inline const uint8_t *data() const { return p; }
+
+	template <class F>
+	inline typename F::type get() const { return F::load(p); }
+};
+
+template <class R>
+class RxView : public RxRecord<R> {
+public:	explicit RxView(RxPacket& pkt) : RxRecord<R>(pkt) {}
+};
+
+//////////////////////////////////////////////////////////////////////
+// High rate fix reports
+//////////////////////////////////////////////////////////////////////
+
+template <>
+class RxView<s_R4A> : public RxRecord<s_R4A> {
+public:	explicit RxView(RxPacket& pkt) : RxRecord<s_R4A>(pkt) {}
+
+	inline float latitude() const { return get<L::latitude>(); }
+	inline float longitude() const { return get<L::longitude>(); }
+	inline float altitude() const { return get<L::altitude>(); }
+	inline float clock_bias() const { return get<L::clock_bias>(); }
+	inline double time_of_fix() const {
+		return sd ? get<L::time_of_fix2>() : get<L::time_of_fix1>();
+	}
+};
+
+template <>
+class RxView<s_R56> : public RxRecord<s_R56> {
+public:	explicit RxView(RxPacket& pkt) : RxRecord<s_R56>(pkt) {}
+
+	inline float eastvel() const { return get<L::eastvel>(); }
+	inline float northvel() const { return get<L::northvel>(); }
+	inline float upvel() const { return get<L::upvel>(); }
+	inline float clock_bias_rate() const { return get<L::clock_bias_rate>(); }
+	inline double time_of_fix() const {
+		return sd ? get<L::time_of_fix2>() : get<L::time_of_fix1>();
+	}
+};
+
+template <>
+class RxView<s_R6D> : public RxRecord<s_R6D> {
+public:	explicit RxView(RxPacket& pkt) : RxRecord<s_R6D>(pkt) {}
+
+	inline uint8_t fixmode() const { return get<L::fixmode>(); }
+	inline float pdop() const { return get<L::pdop>(); }
+	inline float hdop() const { return get<L::hdop>(); }
+	inline float vdop() const { return get<L::vdop>(); }
+	inline float tdop() const { return get<L::tdop>(); }
+
+	inline unsigned count() const {		// Entries in sv_prn(), 0 if !valid()
+		unsigned n = p ? avail - L::size : 0;
+
+		return n < sizeof ((s_R6D *)0)->sv_prn ? n : sizeof ((s_R6D *)0)->sv_prn;
+	}
+	inline uint8_t sv_prn(unsigned x) const { return p[L::size + x]; }
+};
+
+template <>
+class RxView<s_R83> : public RxRecord<s_R83> {
+public:	explicit RxView(RxPacket& pkt) : RxRecord<s_R83>(pkt) {}
+
+	inline double x() const { return get<L::x>(); }
+	inline double y() const { return get<L::y>(); }
+	inline double z() const { return get<L::z>(); }
+	inline double clock_bias() const { return get<L::clock_bias>(); }
+	inline double time_of_fix() const {
+		return sd ? get<L::time_of_fix2>() : get<L::time_of_fix1>();
+	}
+};
+
+template <>
+class RxView<s_R84> : public RxRecord<s_R84> {
+public:	explicit RxView(RxPacket& pkt) : RxRecord<s_R84>(pkt) {}
+
+	inline double latitude() const { return get<L::latitude>(); }
+	inline double longitude() const { return get<L::longitude>(); }
+	inline double altitude() const { return get<L::altitude>(); }
+	inline double clock_bias() const { return get<L::clock_bias>(); }
+	inline double time_of_fix() const {
+		return sd ? get<L::time_of_fix2>() : get<L::time_of_fix1>();
+	}
+};
+
+#endif // RXVIEW_HPP
+
+// End rxview.hpp
@@ -0,0 +1,264 @@
+//////////////////////////////////////////////////////////////////////
+// serial.cpp -- Serial Port Configuration
+// Date: Sun Oct 18 15:04:10 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+
+#include "serial.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Supported rates
+//////////////////////////////////////////////////////////////////////
+
+static const struct {
+	unsigned	baud;
+	speed_t		speed;
+} bauds[] = {
+	{ 1200, B1200 },
+	{ 2400, B2400 },
+	{ 4800, B4800 },
+	{ 9600, B9600 },
+	{ 19200, B19200 },
+	{ 38400, B38400 },
+#ifdef B57600
+	{ 57600, B57600 },
+#endif
+#ifdef B115200
+	{ 115200, B115200 },
+#endif
+#ifdef B230400
+	{ 230400, B230400 },
+#endif
+#ifdef B460800
+	{ 460800, B460800 },
+#endif
+#ifdef B921600
+	{ 921600, B921600 },
+#endif
+#ifdef B1000000
+	{ 1000000, B1000000 },
+#endif
+#ifdef B2000000
+	{ 2000000, B2000000 },
+#endif
+#ifdef B4000000
+	{ 4000000, B4000000 },
+#endif
+	{ 0, B0 }
+};
+
+static bool
+lookup(unsigned baud,speed_t& speed) {
+
+	for ( int x=0; bauds[x].baud; ++x ) {
+		if ( bauds[x].baud == baud ) {
+			speed = bauds[x].speed;
+			return true;
+		}
+	}
+	return false;
+}
+
+SerialConfig::SerialConfig() {
+	lowlat_ok = false;
+	ftdi_ok = false;
+	baud = 9600;
+	databits = 8;
+	parity = 'O';
+	stopbits = 1;
+	vmin = 1;
+	vtime = 0;
+	low_latency = true;
+	ftdi_latency = 1;
+}
+
+bool
+SerialConfig::valid_baud(unsigned baud) {
+	speed_t speed;
+
+	return lookup(baud,speed);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bits per byte on the wire: start + data + parity + stop
+//////////////////////////////////////////////////////////////////////
+
+unsigned
+SerialConfig::char_bits() const {
+	return 1 + databits + (parity != 'N' ? 1 : 0) + stopbits;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Parse "baud" or "baud,<databits><parity><stopbits>", for example
+// "115200" or "38400,8N1". Fields not given are left unchanged.
+//
+// RETURNS:
+//	true	- Settings updated
+//	false	- Bad spec (nothing changed)
+//////////////////////////////////////////////////////////////////////
+
+bool
+SerialConfig::parse(const char *spec) {
+	char *ep;
+	unsigned long b;
+	int d = databits, s = stopbits;
+	char p = parity;
+
+	b = strtoul(spec,&ep,10);
+	if ( ep == spec || !valid_baud(b) )
+		return false;
+
+	if ( *ep == ',' ) {
+		++ep;
+		if ( ep[0] < '5' || ep[0] > '8' )
+			return false;
+		d = ep[0] - '0';
+		switch ( ep[1] ) {
+		case 'N' : case 'n' :
+		case 'O' : case 'o' :
+		case 'E' : case 'e' :
+			p = ep[1] & ~0x20;	// Upper case
+			break;
+		default :
+			return false;
+		}
+		if ( ep[2] != '1' && ep[2] != '2' )
+			return false;
+		s = ep[2] - '0';
+		ep += 3;
+	}
+	if ( *ep )
+		return false;
+
+	baud = b;
+	databits = d;
+	parity = p;
+	stopbits = s;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Set the FTDI latency timer through sysfs (Linux)
+//////////////////////////////////////////////////////////////////////
+
+static bool
+ftdi_timer(int fd,const char *device,int ms) {
+#ifdef __linux__
+	char real[PATH_MAX], path[PATH_MAX+64];
+	const char *name;
+	FILE *f;
+	int rc;
+
+	if ( !device && !(device = ttyname(fd)) )
+		return false;
+	if ( !realpath(device,real) )
+		return false;
+	name = strrchr(real,'/');
+	name = name ? name + 1 : real;
+
+	snprintf(path,sizeof path,"/sys/bus/usb-serial/devices/%s/latency_timer",name);
+	if ( !(f = fopen(path,"w")) )
+		return false;			// Not FTDI, or no permission
+	rc = fprintf(f,"%d\n",ms);
+	if ( fclose(f) )
+		rc = -1;
+	return rc > 0;
+#else
+	return false;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Set or clear ASYNC_LOW_LATENCY (Linux)
+//////////////////////////////////////////////////////////////////////
+
+static bool
+async_low_latency(int fd,bool on) {
+#if defined(__linux__) && defined(TIOCGSERIAL)
+	struct serial_struct ss;
+
+	if ( ioctl(fd,TIOCGSERIAL,&ss) < 0 )
+		return false;
+	if ( on )
+		ss.flags |= ASYNC_LOW_LATENCY;
+	else	ss.flags &= ~ASYNC_LOW_LATENCY;
+	return ioctl(fd,TIOCSSERIAL,&ss) == 0;
+#else
+	return false;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Apply the settings to tty fd (device is used to find the FTDI
+// latency timer; if 0, ttyname(fd) is used)
+//
+// RETURNS:
+//	true	- Termios settings applied
+//	false	- Not a tty, or tcsetattr() failed (see errno)
+//////////////////////////////////////////////////////////////////////
+
+bool
+SerialConfig::apply(int fd,const char *device) {
+	struct termios tios;
+	speed_t speed;
+
+	lowlat_ok = ftdi_ok = false;
+
+	if ( !lookup(baud,speed) ) {
+		errno = EINVAL;
+		return false;
+	}
+	if ( tcgetattr(fd,&tios) )
+		return false;
+
+	cfmakeraw(&tios);
+	cfsetspeed(&tios,speed);
+
+	tios.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB);
+	switch ( databits ) {
+	case 5 :
+		tios.c_cflag |= CS5;
+		break;
+	case 6 :
+		tios.c_cflag |= CS6;
+		break;
+	case 7 :
+		tios.c_cflag |= CS7;
+		break;
+	default :
+		tios.c_cflag |= CS8;
+	}
+	if ( parity == 'O' )
+		tios.c_cflag |= PARENB | PARODD;
+	else if ( parity == 'E' )
+		tios.c_cflag |= PARENB;
+	if ( stopbits == 2 )
+		tios.c_cflag |= CSTOPB;
+	tios.c_cflag |= CREAD | CLOCAL;
+
+	tios.c_cc[VMIN] = vmin;
+	tios.c_cc[VTIME] = vtime;
+
+	if ( tcsetattr(fd,TCSANOW,&tios) )
+		return false;
+
+	lowlat_ok = async_low_latency(fd,low_latency);
+	if ( ftdi_latency > 0 )
+		ftdi_ok = ftdi_timer(fd,device,ftdi_latency);
+	return true;
+}
+
+// End serial.cpp
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////
+// serial.hpp -- Serial Port Configuration
+// Date: Sun Oct 18 15:02:44 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef SERIAL_HPP
+#define SERIAL_HPP
+
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////////
+// Serial port settings, applied to a tty by apply(). The defaults
+// are the TSIP defaults (9600 8O1, raw), with the driver's latency
+// reduced as far as it allows:
+//
+//	vmin/vtime	- Raw mode read()/poll() wakeup (VMIN=1, VTIME=0:
+//			  wake on every byte)
+//	low_latency	- Set ASYNC_LOW_LATENCY (Linux), so the driver
+//			  pushes received bytes up without deferring
+//	ftdi_latency	- FTDI adapter latency timer in ms (1..255, -1
+//			  leaves it alone). The default of 16 ms delays
+//			  every short read by up to 16 ms.
+//
+// low_latency and ftdi_latency are best effort: drivers without
+// them (and missing sysfs permissions) are not an error. The result
+// is available from low_latency_ok() and ftdi_latency_ok().
+//////////////////////////////////////////////////////////////////////
+
+class SerialConfig {
+	bool	lowlat_ok;	// ASYNC_LOW_LATENCY applied by apply()
+	bool	ftdi_ok;	// Latency timer applied by apply()
+
+public:	unsigned baud;		// Bits per second (9600..4000000)
+	int	databits;	// 5..8
+	char	parity;		// 'N', 'O' or 'E'
+	int	stopbits;	// 1 or 2
+	int	vmin;		// Termios VMIN
+	int	vtime;		// Termios VTIME (tenths of a second)
+	bool	low_latency;	// Request ASYNC_LOW_LATENCY
+	int	ftdi_latency;	// FTDI latency timer ms (-1 = leave)
+
+	SerialConfig();
+
+	bool parse(const char *spec);		// "115200[,8O1]"
+	bool apply(int fd,const char *device=0);
+
+	unsigned char_bits() const;		// Bits on the wire per byte
+	static bool valid_baud(unsigned baud);
+
+	inline bool low_latency_ok() const { return lowlat_ok; }
+	inline bool ftdi_latency_ok() const { return ftdi_ok; }
+};
+
+#endif // SERIAL_HPP
+
+// End serial.hpp
@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////
+// spscring.hpp -- Single Producer, Single Consumer Ring
+// Date: Sun Oct 18 19:20:41 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef SPSCRING_HPP
+#define SPSCRING_HPP
+
+#include <atomic>
+#include <assert.h>
+
+//////////////////////////////////////////////////////////////////////
+// A fixed ring of size slots (power of 2), filled in place by one
+// producer thread and drained in place by one consumer thread. No
+// locks and no waiting: every call completes in a bounded number of
+// steps. The producer claim()s a slot, fills it and publish()es it;
+// the consumer peek()s at the ready slots, uses them and release()s
+// them. Head and tail live on separate cache lines.
+//////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class SpscRing {
+	T	*slots;		// size slots
+	unsigned size;		// Number of slots (power of 2)
+
+	alignas(64) std::atomic<unsigned> head;	// Next slot to publish
+	unsigned tail_cache;			// Producer's copy of tail
+
+	alignas(64) std::atomic<unsigned> tail;	// Next slot to release
+	unsigned head_cache;			// Consumer's copy of head
+
+public:	SpscRing() : slots(0), size(0), head(0), tail_cache(0), tail(0), head_cache(0) {}
+	~SpscRing() { delete[] slots; }
+
+	SpscRing(const SpscRing&) = delete;
+	SpscRing& operator=(const SpscRing&) = delete;
+
+	void open(unsigned nslots) {
+		assert(nslots && !(nslots & (nslots - 1)));
+		delete[] slots;
+		slots = new T[nslots];
+		size = nslots;
+		head = tail = tail_cache = head_cache = 0;
+	}
+
+	inline unsigned capacity() const { return size; }
+	inline T& slot(unsigned x) { return slots[x & (size - 1)]; } // By index
+
+	//////////////////////////////////////////////////////////////
+	// Producer: slot to fill next, or 0 if the ring is full
+	//////////////////////////////////////////////////////////////
+
+	T *claim() {
+		unsigned h = head.load(std::memory_order_relaxed);
+
+		if ( h - tail_cache >= size ) {
+			tail_cache = tail.load(std::memory_order_acquire);
+			if ( h - tail_cache >= size )
+				return 0;
+		}
+		return &slots[h & (size - 1)];
+	}
+
+	inline void publish() {
+		head.store(head.load(std::memory_order_relaxed) + 1,std::memory_order_release);
+	}
+
+	//////////////////////////////////////////////////////////////
+	// Consumer: number of ready slots from *first on that are
+	// contiguous in memory (0 if empty)
+	//////////////////////////////////////////////////////////////
+
+	unsigned peek(T **first) {
+		unsigned t = tail.load(std::memory_order_relaxed), n;
+
+		if ( head_cache == t )
+			head_cache = head.load(std::memory_order_acquire);
+		n = head_cache - t;
+		if ( n > size - (t & (size - 1)) )
+			n = size - (t & (size - 1));	// Up to the wrap
+		*first = &slots[t & (size - 1)];
+		return n;
+	}
+
+	inline void release(unsigned n) {
+		tail.store(tail.load(std::memory_order_relaxed) + n,std::memory_order_release);
+	}
+
+	//////////////////////////////////////////////////////////////
+	// Slots in use (exact only from the producer or consumer)
+	//////////////////////////////////////////////////////////////
+
+	inline unsigned depth() const {
+		return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+	}
+};
+
+#endif // SPSCRING_HPP
+
+// End spscring.hpp
@@ -0,0 +1,452 @@
+//////////////////////////////////////////////////////////////////////
+// transport.cpp -- Packet Transports (tty, file, pty, sockets)
+// Date: Sun Oct 18 16:34:52 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <errno.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "transport.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Plain fd
+//////////////////////////////////////////////////////////////////////
+
+Transport::Transport() {
+	tfd = -1;
+	owned = false;
+	tname = 0;
+}
+
+Transport::~Transport() {
+	Transport::close();
+	free(tname);
+	tname = 0;
+}
+
+void
+Transport::set_name(const char *name) {
+	free(tname);
+	tname = name ? strdup(name) : 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Use an fd that is already open (closed by close() if owned)
+//////////////////////////////////////////////////////////////////////
+
+bool
+Transport::attach(int fd,bool owned) {
+
+	close();
+	if ( fd < 0 ) {
+		errno = EBADF;
+		return false;
+	}
+	tfd = fd;
+	this->owned = owned;
+	return true;
+}
+
+void
+Transport::close() {
+
+	if ( tfd >= 0 && owned )
+		::close(tfd);
+	tfd = -1;
+	owned = false;
+}
+
+size_t
+Transport::read_size() const {
+	return 65536;			// A full pipe
+}
+
+bool
+Transport::configure(SerialConfig& cfg) {
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Serial port
+//////////////////////////////////////////////////////////////////////
+
+bool
+TtyTransport::open(const char *path,SerialConfig& cfg) {
+	int fd = ::open(path,O_RDWR|O_NOCTTY);
+
+	if ( fd < 0 )
+		return false;
+	set_name(path);
+	if ( !attach(fd,cfg,true) ) {
+		int e = errno;
+
+		::close(fd);
+		errno = e;
+		return false;
+	}
+	return true;
+}
+
+bool
+TtyTransport::attach(int fd,SerialConfig& cfg,bool owned) {
+
+	if ( !Transport::attach(fd,owned) )
+		return false;
+	if ( !isatty(fd) ) {
+		errno = ENOTTY;
+		tfd = -1;
+		return false;
+	}
+	if ( !tname )
+		set_name(ttyname(fd));
+	if ( !configure(cfg) ) {
+		tfd = -1;
+		return false;
+	}
+	return true;
+}
+
+size_t
+TtyTransport::read_size() const {
+	return 4096;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Apply new port settings. Output still queued is sent at the old
+// settings first.
+//////////////////////////////////////////////////////////////////////
+
+bool
+TtyTransport::configure(SerialConfig& cfg) {
+
+	tcdrain(tfd);
+	if ( !cfg.apply(tfd,tname) )
+		return false;
+	serial = cfg;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Capture file
+//////////////////////////////////////////////////////////////////////
+
+bool
+FileTransport::open(const char *path) {
+	int fd = ::open(path,O_RDONLY);
+
+	if ( fd < 0 )
+		return false;
+	set_name(path);
+	return attach(fd,true);
+}
+
+bool
+FileTransport::attach(int fd,bool owned) {
+
+	if ( !Transport::attach(fd,owned) )
+		return false;
+#ifdef POSIX_FADV_SEQUENTIAL
+	posix_fadvise(fd,0,0,POSIX_FADV_SEQUENTIAL);
+#endif
+	return true;
+}
+
+size_t
+FileTransport::read_size() const {
+	return 262144;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pseudo terminal
+//////////////////////////////////////////////////////////////////////
+
+PtyTransport::~PtyTransport() {
+	PtyTransport::close();
+}
+
+bool
+PtyTransport::open() {
+	struct termios tios;
+	const char *slave;
+	int fd;
+
+	if ( (fd = posix_openpt(O_RDWR|O_NOCTTY)) < 0 )
+		return false;
+	if ( grantpt(fd) || unlockpt(fd) || !(slave = ptsname(fd)) ) {
+		int e = errno;
+
+		::close(fd);
+		errno = e;
+		return false;
+	}
+	set_name(slave);
+	attach(fd,true);
+
+	// Raw, so TSIP passes through the line discipline untouched
+	slave_fd = ::open(slave,O_RDWR|O_NOCTTY);
+	if ( slave_fd >= 0 && !tcgetattr(slave_fd,&tios) ) {
+		cfmakeraw(&tios);
+		tcsetattr(slave_fd,TCSANOW,&tios);
+	}
+	return true;
+}
+
+void
+PtyTransport::close() {
+
+	if ( slave_fd >= 0 )
+		::close(slave_fd);
+	slave_fd = -1;
+	Transport::close();
+}
+
+//////////////////////////////////////////////////////////////////////
+// Sockets
+//////////////////////////////////////////////////////////////////////
+
+bool
+SocketTransport::tune() {
+	int on = 1;
+	struct sockaddr_storage sa;
+	socklen_t salen = sizeof sa;
+
+	if ( getsockname(tfd,(struct sockaddr *)&sa,&salen) )
+		return false;
+	if ( sa.ss_family == AF_INET || sa.ss_family == AF_INET6 )
+		return !setsockopt(tfd,IPPROTO_TCP,TCP_NODELAY,&on,sizeof on);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Connect to host:port (a serial-to-Ethernet bridge)
+//////////////////////////////////////////////////////////////////////
+
+bool
+SocketTransport::connect_tcp(const char *host,const char *port) {
+	struct addrinfo hints, *res, *ai;
+	char desc[512];
+	int fd = -1, rc;
+
+	memset(&hints,0,sizeof hints);
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	if ( (rc = getaddrinfo(host,port,&hints,&res)) != 0 ) {
+		errno = rc == EAI_SYSTEM ? errno : EHOSTUNREACH;
+		return false;
+	}
+
+	for ( ai=res; ai; ai=ai->ai_next ) {
+		fd = socket(ai->ai_family,ai->ai_socktype,ai->ai_protocol);
+		if ( fd < 0 )
+			continue;
+		if ( !connect(fd,ai->ai_addr,ai->ai_addrlen) )
+			break;
+		::close(fd);
+		fd = -1;
+	}
+	freeaddrinfo(res);
+	if ( fd < 0 )
+		return false;
+
+	snprintf(desc,sizeof desc,"%s:%s",host,port);
+	set_name(desc);
+	attach(fd,true);
+	tune();
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Listen on [host:]port and wait for one connection (host 0 : any)
+//////////////////////////////////////////////////////////////////////
+
+bool
+SocketTransport::listen_tcp(const char *host,const char *port) {
+	struct addrinfo hints, *res;
+	char desc[512];
+	int lfd, fd, on = 1, rc;
+
+	memset(&hints,0,sizeof hints);
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_PASSIVE;
+
+	if ( (rc = getaddrinfo(host,port,&hints,&res)) != 0 ) {
+		errno = rc == EAI_SYSTEM ? errno : EADDRNOTAVAIL;
+		return false;
+	}
+
+	lfd = socket(res->ai_family,res->ai_socktype,res->ai_protocol);
+	if ( lfd < 0 ) {
+		freeaddrinfo(res);
+		return false;
+	}
+	setsockopt(lfd,SOL_SOCKET,SO_REUSEADDR,&on,sizeof on);
+	rc = bind(lfd,res->ai_addr,res->ai_addrlen);
+	freeaddrinfo(res);
+	if ( rc || listen(lfd,1) ) {
+		int e = errno;
+
+		::close(lfd);
+		errno = e;
+		return false;
+	}
+
+	do	{
+		fd = accept(lfd,0,0);
+	} while ( fd < 0 && errno == EINTR );
+	::close(lfd);
+	if ( fd < 0 )
+		return false;
+
+	snprintf(desc,sizeof desc,"%s:%s",host ? host : "*",port);
+	set_name(desc);
+	attach(fd,true);
+	tune();
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Connect to a Unix stream socket
+//////////////////////////////////////////////////////////////////////
+
+bool
+SocketTransport::connect_unix(const char *path) {
+	struct sockaddr_un sun;
+	int fd;
+
+	if ( strlen(path) >= sizeof sun.sun_path ) {
+		errno = ENAMETOOLONG;
+		return false;
+	}
+	memset(&sun,0,sizeof sun);
+	sun.sun_family = AF_UNIX;
+	strcpy(sun.sun_path,path);
+
+	if ( (fd = socket(AF_UNIX,SOCK_STREAM,0)) < 0 )
+		return false;
+	if ( connect(fd,(struct sockaddr *)&sun,sizeof sun) ) {
+		int e = errno;
+
+		::close(fd);
+		errno = e;
+		return false;
+	}
+	set_name(path);
+	return attach(fd,true);
+}
+
+size_t
+SocketTransport::read_size() const {
+	return 65536;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Open a transport from a spec (see transport.hpp). cfg applies to
+// serial ports (defaults if 0).
+//
+// RETURNS:
+//	Transport	- Open transport (caller deletes)
+//	0		- Failed (see errno)
+//////////////////////////////////////////////////////////////////////
+
+Transport *
+Transport::create(const char *spec,const SerialConfig *cfg) {
+	SerialConfig serial;
+	Transport *t = 0;
+	struct stat st;
+	bool ok = false;
+
+	if ( cfg )
+		serial = *cfg;
+
+	if ( !strcmp(spec,"-") ) {
+		if ( fstat(0,&st) )
+			return 0;
+		if ( isatty(0) ) {
+			TtyTransport *tty = new TtyTransport;
+			t = tty;
+			ok = tty->attach(0,serial,false);
+		} else if ( S_ISREG(st.st_mode) ) {
+			FileTransport *file = new FileTransport;
+			t = file;
+			ok = file->attach(0,false);
+		} else	{
+			t = new Transport;
+			ok = t->attach(0,false);
+		}
+		if ( ok )
+			t->set_name("stdin");
+	} else if ( !strncmp(spec,"tcp:",4) || !strncmp(spec,"tcp-listen:",11) ) {
+		bool server = spec[3] == '-';
+		const char *addr = strchr(spec,':') + 1;
+		const char *colon = strrchr(addr,':');
+		SocketTransport *sock = new SocketTransport;
+		char host[256];
+
+		t = sock;
+		if ( !colon ) {
+			if ( server )
+				ok = sock->listen_tcp(0,addr);
+			else	errno = EINVAL;
+		} else if ( size_t(colon - addr) < sizeof host ) {
+			memcpy(host,addr,colon-addr);
+			host[colon-addr] = 0;
+			if ( server )
+				ok = sock->listen_tcp(*host ? host : 0,colon+1);
+			else	ok = sock->connect_tcp(host,colon+1);
+		} else	errno = ENAMETOOLONG;
+	} else if ( !strncmp(spec,"unix:",5) ) {
+		SocketTransport *sock = new SocketTransport;
+
+		t = sock;
+		ok = sock->connect_unix(spec+5);
+	} else if ( !strncmp(spec,"pty:",4) ) {
+		PtyTransport *pty = new PtyTransport;
+
+		t = pty;
+		ok = pty->open();
+	} else if ( !strncmp(spec,"file:",5) ) {
+		FileTransport *file = new FileTransport;
+
+		t = file;
+		ok = file->open(spec+5);
+	} else	{
+		const char *path = !strncmp(spec,"tty:",4) ? spec+4 : spec;
+
+		if ( path == spec && !stat(path,&st) && S_ISREG(st.st_mode) ) {
+			FileTransport *file = new FileTransport;
+
+			t = file;
+			ok = file->open(path);
+		} else	{
+			TtyTransport *tty = new TtyTransport;
+
+			t = tty;
+			ok = tty->open(path,serial);
+		}
+	}
+
+	if ( !ok ) {
+		int e = errno;
+
+		delete t;
+		errno = e;
+		return 0;
+	}
+	return t;
+}
+
+// End transport.cpp
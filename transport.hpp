@@ -0,0 +1,125 @@
+//////////////////////////////////////////////////////////////////////
+// transport.hpp -- Packet Transports (tty, file, pty, sockets)
+// Date: Sun Oct 18 16:31:05 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "serial.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Where Packet reads TSIP from and writes commands to. Every
+// transport ends up as one fd that Packet (and Reactor) poll, read
+// and write directly; a transport only opens it, tunes it for its
+// type, and says how large Packet's reads should be.
+//
+// Transport itself is a plain fd (pipe, stdin, or an fd opened
+// elsewhere). create() opens a transport from a spec:
+//
+//	-			stdin
+//	tty:path		Serial port (also a path to a char device)
+//	file:path		Capture file (also a path to a regular file)
+//	pty:			New pty; the other end is name()
+//	tcp:host:port		TCP client (serial-to-Ethernet bridge)
+//	tcp-listen:[host:]port	TCP server: accepts one connection
+//	unix:path		Unix stream socket client
+//////////////////////////////////////////////////////////////////////
+
+class Transport {
+protected:
+	int	tfd;		// Open fd (-1 if closed)
+	bool	owned;		// close() closes tfd
+	char	*tname;		// Description (path, address)
+
+	void set_name(const char *name);
+
+public:	Transport();
+	virtual ~Transport();
+
+	bool attach(int fd,bool owned=true);
+	virtual void close();
+
+	virtual size_t read_size() const;	// Preferred read() size
+	virtual bool pollable() const { return true; } // False: never blocks
+	virtual bool configure(SerialConfig& cfg); // False: not a tty
+	virtual const SerialConfig *config() const { return 0; }
+	virtual const char *kind() const { return "fd"; }
+
+	inline int fd() const { return tfd; }
+	inline const char *name() const { return tname ? tname : ""; }
+
+	static Transport *create(const char *spec,const SerialConfig *cfg=0);
+};
+
+//////////////////////////////////////////////////////////////////////
+// Serial port: SerialConfig applied at open, small reads (a tty
+// read returns what has arrived, so latency matters, not size)
+//////////////////////////////////////////////////////////////////////
+
+class TtyTransport : public Transport {
+	SerialConfig serial;	// Settings applied
+
+public:	bool open(const char *path,SerialConfig& cfg);
+	bool attach(int fd,SerialConfig& cfg,bool owned=true);
+
+	virtual size_t read_size() const;
+	virtual bool configure(SerialConfig& cfg);
+	virtual const SerialConfig *config() const { return &serial; }
+	virtual const char *kind() const { return "tty"; }
+};
+
+//////////////////////////////////////////////////////////////////////
+// Capture file: sequential readahead and large reads
+//////////////////////////////////////////////////////////////////////
+
+class FileTransport : public Transport {
+public:	bool open(const char *path);
+	bool attach(int fd,bool owned=true);
+
+	virtual size_t read_size() const;
+	virtual bool pollable() const { return false; }
+	virtual const char *kind() const { return "file"; }
+};
+
+//////////////////////////////////////////////////////////////////////
+// New pseudo terminal. Packet uses the master; a simulator or other
+// program opens the slave, name(). The slave is held open here too,
+// so the master does not see EIO while nobody has it open.
+//////////////////////////////////////////////////////////////////////
+
+class PtyTransport : public Transport {
+	int	slave_fd;	// Our hold on the slave
+
+public:	PtyTransport() : slave_fd(-1) {}
+	~PtyTransport();
+
+	bool open();
+	virtual void close();
+
+	virtual const char *kind() const { return "pty"; }
+};
+
+//////////////////////////////////////////////////////////////////////
+// Stream sockets: TCP_NODELAY on TCP, so commands are not held back
+// by Nagle, and large reads
+//////////////////////////////////////////////////////////////////////
+
+class SocketTransport : public Transport {
+protected:
+	bool tune();				// Set socket options
+
+public:	bool connect_tcp(const char *host,const char *port);
+	bool listen_tcp(const char *host,const char *port);
+	bool connect_unix(const char *path);
+
+	virtual size_t read_size() const;
+	virtual const char *kind() const { return "socket"; }
+};
+
+#endif // TRANSPORT_HPP
+
+// End transport.hpp
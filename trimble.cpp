@@ -7,18 +7,32 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <string.h>
+#include <math.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <termios.h>
+#include <time.h>
+#include <poll.h>
 #include <assert.h>
 
 #include "ttyio.hpp"
 #include "tsip.hpp"
+#include "dlescan.hpp"
+#include "rxthread.hpp"
+#include "cmdchan.hpp"
+#include "uartpkt.hpp"
+#include "uartsim.hpp"
+#include "tsiplen.hpp"
+#include "msgtraits.hpp"
+#include "rptbatch.hpp"
+#include "fixpt.hpp"
 
 #include <unordered_set>
+#include <vector>
 
 struct termios tios, sv_tios;
 bool quit = false;
+int quit_pipe[2] = { -1, -1 };	// Readable: 'q' was typed (pkt's cancel fd)
 
 static void
 cdump(uint8_t *packet,int plen) {
@@ -33,12 +47,19 @@ cdump(uint8_t *packet,int plen) {
 	fflush(stdout);
 }
 
+// Put the terminal back as it was (registered with atexit())
+static void
+restore_tty() {
+	tcsetattr(0,TCSANOW,&sv_tios);
+}
+
 static void
 cmdcb(Packet& pkt,char cmd) {
 	TxPacket tx;
 	uint8_t buf[512];
 
 	tx.open(buf,sizeof buf);
+	flockfile(stdout);		// Not inside a packet's output
 
 	fprintf(stderr,"\nCMD = '%c'\n",cmd);
 	fflush(stderr);
@@ -85,7 +106,7 @@ cmdcb(Packet& pkt,char cmd) {
 			p.posfx_rate 	= 0;
 
 			tx.CBB00(p);
-			pkt.put(buf,tx.size());
+			pkt.put(tx);
 			cdump(buf,tx.size());
 		}
 		break;
@@ -108,115 +129,117 @@ cmdcb(Packet& pkt,char cmd) {
 			p.mbz = 0;
 
 			tx.C8EA5(p);
-			pkt.put(buf,tx.size());
+			pkt.put(tx);
 			cdump(buf,tx.size());
 		}
 		break;
 	case 's' :
 		printf("3C - Satellite Tracking Status\n");
 		tx.C3C();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'a' :
 		printf("3A - Last Raw Measurement Request for sat PRN 0\n");
 		tx.C3A();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'E' :
 		printf("3B - Satellite Ephemeris Status Request\n");
 		tx.C3B(0);
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'l' :
 		printf("37 - Last Position and Velocity Request (l)\n");
 		tx.C37();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'A' :
 		printf("20 - Almanac Request (A)\n");
 		tx.C20();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 't' :
 		printf("21 - Time Request\n");
 		tx.C21();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'v' :
 		printf("1C01 - Software Version\n");
 		tx.C1C01();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'V' :
 		printf("1C03 - Hardware version\n");
 		tx.C1C03();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'p' :
 		printf("24 - GPS Receiver Position Fix Mode Request\n");
 		tx.C24();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'r' :
 		printf("25 - Soft Reset/Self Test (r)\n");
 		tx.C25();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'm' :
 		printf("28 - GPS System Message Request (m)\n");
 		tx.C28();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'h' :
 		printf("26 - Health Request\n");
 		tx.C26();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'k' :
 		printf("1E 'K' - Cold Reset (K)\n");
 		tx.C1E('K');
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'F' :
 		printf("1E 'R' - Factory Reset (F)\n");
 		tx.C1E('R');
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'L' :
 		printf("27 - Signal Levels Request (L)\n");
 		tx.C27();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'f' :
 		printf("1F - Software Versions Request(f)\n");
 		tx.C1F();
-		pkt.put(buf,tx.size());
+		pkt.put(tx);
 		cdump(buf,tx.size());
 		break;
 	case 'x' :
 	case 'q' :
-		tcsetattr(0,TCSANOW,&sv_tios);
-		exit(0);
+		// main() sees EOF, then stops us and reports as usual
+		quit = true;
+		(void)!write(quit_pipe[1],"",1);	// Can only fail if already written
 		break;
 	}
 
 	fflush(stdout);
 	fflush(stderr);
+	funlockfile(stdout);
 }
 
 static void
@@ -233,464 +256,1103 @@ dump(uint8_t *packet,int plen,bool ended) {
 	fflush(stdout);
 }
 
-int
-main(int argc,char **argv) {
-	Packet pkt;
-	RxPacket rxpkt;
-	uint8_t *packet = 0;
-	int pktlen;
-	int rc;
-	bool ended;
-	std::unordered_set<uint8_t> idset;
-	uint16_t id;
+//////////////////////////////////////////////////////////////////////
+// Show when a packet arrived, and how long it took to arrive
+//////////////////////////////////////////////////////////////////////
 
-	if ( argc < 2 ) {
-		pkt.open();
-		pkt.registercb(cmdcb);
+static void
+tdump(const s_pktstamp& st) {
 
-		rc = tcgetattr(0,&tios);
-		sv_tios = tios;
-		assert(!rc);
-		cfmakeraw(&tios);
-		tios.c_oflag |= OPOST | ONLCR;
-		rc = tcsetattr(0,TCSANOW,&tios);
-		assert(!rc);
-	} else	{
-		pkt.open(0,1024,0);
+	printf("  @ %llu.%09llu (%.3f ms)\n",
+		(unsigned long long)(st.real_start / 1000000000ull),
+		(unsigned long long)(st.real_start % 1000000000ull),
+		double(st.mono_end - st.mono_start) / 1e6);
+}
+
+static void
+iostats(Packet& pkt) {
+	const s_iostats& st = pkt.stats();
+
+	printf("\nI/O Statistics:\n");
+	printf("  packets  %lu\n",st.packets);
+	printf("  bytes    %lu\n",st.bytes);
+	printf("  polls    %lu\n",st.polls);
+	printf("  reads    %lu\n",st.reads);
+	if ( st.packets > 0 )
+		printf("  syscalls/packet %.3f\n",double(st.polls+st.reads)/st.packets);
+	if ( st.lat_n > 0 )
+		printf("  ETX latency  mean %.3f us, max %.3f us\n",
+			double(st.lat_sum_ns) / st.lat_n / 1e3,
+			double(st.lat_max_ns) / 1e3);
+
+	const s_framestats& fs = pkt.framing();
+
+	if ( fs.dropped || fs.resyncs ) {
+		printf("  dropped  %lu bytes (%lu rejected, %lu truncated, %lu overflows)\n",
+			fs.dropped,fs.rejected,fs.truncated,fs.overflows);
+		printf("  resyncs  %lu (%lu bytes recovered)\n",fs.resyncs,fs.recovered);
 	}
+}
+
+static void
+rxstats(RxThread& rx) {
+	s_rxstats st = rx.stats();
+
+	printf("\nReader Thread:\n");
+	printf("  packets  %lu\n",st.packets);
+	printf("  overruns %lu (%lu bytes)\n",st.overruns,st.overrun_bytes);
+	printf("  waits    %lu (ring full)\n",st.full_waits);
+	printf("  batches  %lu",st.batches);
+	if ( st.batches > 0 )
+		printf(" (%.2f packets/batch)",double(st.taken) / st.batches);
+	printf("\n  high water %u slots\n",st.high_water);
+}
+
+//////////////////////////////////////////////////////////////////////
+// AVR build simulation: the source is played into a UartPacket by a
+// simulated receive ISR at the serial rate
+//////////////////////////////////////////////////////////////////////
+
+typedef UartPacket<1024,128> HostUart;
+
+static void
+uart_isr(uint8_t byte,void *arg) {
+	((HostUart *)arg)->isr_rx(byte);
+}
+
+static bool
+uart_get(HostUart& upkt,UartSim& sim,uint8_t **packet,int *length,bool& ended) {
+	bool fin;
 
 	for (;;) {
-		fflush(stdout);
-		fflush(stderr);
+		fin = sim.done();		// Before get(): no bytes missed
+		if ( upkt.get(packet,length,ended) )
+			return true;
+		if ( fin )
+			return upkt.flush() && upkt.get(packet,length,ended);
+		pause();			// Until the next "interrupt"
+	}
+}
+
+static void
+uartstats(HostUart& upkt,UartSim& sim) {
+	const s_framestats& fs = upkt.framing();
+
+	printf("\nUART Simulation:\n");
+	printf("  bytes    %lu\n",sim.bytes());
+	printf("  overruns %u bytes\n",upkt.overruns());
+	printf("  RAM      %u bytes (static)\n",unsigned(sizeof upkt));
+	if ( fs.dropped || fs.resyncs ) {
+		printf("  dropped  %lu bytes (%lu rejected, %lu truncated, %lu overflows)\n",
+			fs.dropped,fs.rejected,fs.truncated,fs.overflows);
+		printf("  resyncs  %lu (%lu bytes recovered)\n",fs.resyncs,fs.recovered);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Frame packets only (no decode or dump) and report throughput
+//////////////////////////////////////////////////////////////////////
+
+static int
+frame_only(Packet& pkt) {
+	struct timespec t0, t1;
+	uint8_t *packet = 0;
+	int pktlen;
+	bool ended;
+	unsigned long npkts = 0, nbytes = 0;
+	double secs;
+
+	clock_gettime(CLOCK_MONOTONIC,&t0);
+	for (;;) {
 		pkt.get(&packet,&pktlen,ended);
-		if ( pktlen <= 0 ) {
-			puts("<EOF>");
+		if ( pktlen <= 0 )
 			break;
+		++npkts;
+		nbytes += pktlen;
+	}
+	clock_gettime(CLOCK_MONOTONIC,&t1);
+
+	secs = double(t1.tv_sec - t0.tv_sec) + double(t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+	printf("Scanner %s: %lu packets, %lu payload bytes, %lu input bytes\n",
+		dle_scan_name(dle_scan_kind()),npkts,nbytes,pkt.stats().bytes);
+	printf("  %.6f secs, %.1f MB/s\n",secs,
+		secs > 0 ? double(pkt.stats().bytes) / secs / 1e6 : 0.0);
+	iostats(pkt);
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Serial latency benchmark
+//
+// For each setting, time n round trips of a Time Request (21) to
+// the arrival of its reply (41). The wire time of both packets is
+// subtracted, leaving the receiver's turnaround plus the driver's
+// delivery latency; the ETX to userspace time is also shown.
+//////////////////////////////////////////////////////////////////////
+
+static const struct {
+	const char	*name;
+	bool		low_latency;
+	int		ftdi_latency;
+	int		vmin;
+	int		vtime;
+} bench_settings[] = {
+	{ "FTDI timer 16 ms",		false,	16,	1,	0 },
+	{ "FTDI timer 1 ms",		false,	1,	1,	0 },
+	{ "Low latency, timer 1 ms",	true,	1,	1,	0 },
+	{ "Low latency, VMIN 0 VTIME 1", true,	1,	0,	1 },
+};
+
+struct s_bench {
+	bool		got;		// Reply seen
+	int		length;		// Reply length
+	uint64_t	etx_ns;		// Read of reply's DLE ETX
+	uint64_t	user_ns;	// Reply handed to us
+	Packet		*pkt;
+};
+
+static uint64_t
+mono_ns() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return uint64_t(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+static void
+bench_cb(void *arg,uint8_t *packet,int length,bool ended) {
+	s_bench& b = *(s_bench *)arg;
+
+	if ( !ended || length < 1 || packet[0] != 0x41 )
+		return;
+	b.user_ns = mono_ns();
+	b.etx_ns = b.pkt->stamp().mono_end;
+	b.length = length;
+	b.got = true;
+}
+
+static int
+benchmark(Packet& pkt,int n) {
+	TxPacket tx;
+	uint8_t buf[64];
+	s_bench b;
+	struct pollfd pfd;
+	unsigned ux;
+	int x, lost;
+	uint64_t t0, rtt, rtt_min, rtt_max, rtt_sum, user_sum;
+	double wire_ms;
+
+	if ( !pkt.get_transport().config() ) {
+		fprintf(stderr,"Benchmark needs a serial port.\n");
+		return 1;
+	}
+
+	tx.open(buf,sizeof buf);
+	tx.C21();
+	b.pkt = &pkt;
+
+	for ( ux=0; ux<sizeof bench_settings/sizeof bench_settings[0]; ++ux ) {
+		SerialConfig cfg = pkt.config();
+
+		cfg.low_latency = bench_settings[ux].low_latency;
+		cfg.ftdi_latency = bench_settings[ux].ftdi_latency;
+		cfg.vmin = bench_settings[ux].vmin;
+		cfg.vtime = bench_settings[ux].vtime;
+		if ( !pkt.configure(cfg) ) {
+			printf("%-28s : rejected (%s)\n",bench_settings[ux].name,strerror(errno));
+			continue;
 		}
-		dump(packet,pktlen,ended);
 
-		rxpkt.load(packet,pktlen);
-		id = rxpkt.id();
-
-		switch ( id ) {
-		case 0x40 :
-			{
-				s_R40 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  satellite = %u\n",r.satellite);
-					printf("  t_zc      = %f\n",r.t_zc);
-					printf("  week_no   = %d\n",r.week_no);
-					printf("  eccentricity = %f\n",r.eccentricity);
-					printf("  t_oa      = %f\n",r.t_oa);
-					printf("  i_o       = %f\n",r.i_o);
-					printf("  omega_dot = %f\n",r.omega_dot);
-					printf("  sqrt_a    = %f\n",r.sqrt_a);
-					printf("  omega_o   = %f\n",r.omega_o);
-					printf("  omega     = %f\n",r.omega);
-					printf("  m_o       = %f\n",r.m_o);
-				}
-			}
-			break;
-		case 0x41 :
-			{
-				s_R41 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  time      = %f\n",r.time);
-					printf("  week      = %d\n",r.week);
-					printf("  offset    = %f\n",r.offset);
-				}
-			}
-			break;
-		case 0x42 :
-			{
-				s_R42 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  X = %f\n",r.x);
-					printf("  Y = %f\n",r.y);
-					printf("  Z = %f\n",r.z);
-					if ( !rxpkt.is_double() )
-						printf("  t = %f GPS secs\n",r.u.time_of_fix1);
-					else 	printf("  t = %lf GPS secs\n",r.u.time_of_fix2);
-				}
-			}
-			break;
-		case 0x43 :
-			{
-				s_R43 r;
-				if ( !rxpkt.get(r) ) {
-					printf("  ERR %u\n",rxpkt.get_offset());
-				} else	{
-					printf("  x_velocity = %f\n",r.x_velocity);
-					printf("  y_velocity = %f\n",r.y_velocity);
-				}
-			}
-			break;
-		case 0x46 :
-			{
-				s_R46 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  status = %d\n",int(r.status));
-					switch ( r.status ) {
-					case DoingPositionFixes	:
-						puts("  (Doing position fixes)");
-						break;
-					case DoNotHaveGPSTimeYet :
-						puts("  (Do not have GPS time yet)");
-						break;
-					case PDOPIsTooHigh :
-						puts("  (PDOP is too high)");
-						break;
-					case NoUsableSatellites	:
-						puts("  (No usable satellites)");
-						break;
-					case Only1UsableSat :
-						puts("  (Only 1 usable satellite)");
-						break;
-					case Only2UsableSats :
-						puts("  (Only 2 usable satellites)");
-						break;
-					case Only3UsableSats :
-						puts("  (Only 3 usable satellites)");
-						break;
-					case ChosenSatIsUnusable :
-						puts("  (Chosen satellite is unusable)");
-						break;
-					default :
-						;		
-					};
-					printf("  error_code = %02X\n",r.u.error_code);
-					printf("    bat failed = %d\n",r.u.flags.battery_failed);
-					printf("    ant fault  = %d\n",r.u.flags.antenna_fault);
-					printf("    exc errors = %d\n",r.u.flags.excessive_errs);
-				}
-			}
-			break;
-		case 0x47 :
-			{
-				s_R47 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  count = %u\n",r.count);
-					for ( unsigned ux=0; ux<r.count; ++ux ) {
-						printf("    %02X level %.lf\n",
-							r.sat[ux].prn,
-							r.sat[ux].siglevel);
-					}
-				}
-			}
-			break;
-		case 0x48 :
-			{
-				s_R48 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf(" message: %-22.22s\n",r.message);
-				}
+		rtt_min = ~uint64_t(0);
+		rtt_max = rtt_sum = user_sum = 0;
+		lost = 0;
+		b.length = 0;
+
+		for ( x=0; x<n; ++x ) {
+			b.got = false;
+			t0 = mono_ns();
+			pkt.put(tx);
+
+			while ( !b.got ) {
+				pfd.fd = pkt.fd();
+				pfd.events = POLLIN;
+				if ( poll(&pfd,1,1000) <= 0 || pkt.pump(bench_cb,&b) < 0 )
+					break;
 			}
-			break;
-		case 0x49 :
-			{
-				s_R49 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					for ( short x=0; x<32; ++x )
-						printf("  %2d : %02X\n",x,r.health[x]);
-				}
+			if ( !b.got ) {
+				++lost;
+				continue;
 			}
+
+			rtt = b.etx_ns - t0;
+			rtt_sum += rtt;
+			user_sum += b.user_ns - b.etx_ns;
+			if ( rtt < rtt_min )
+				rtt_min = rtt;
+			if ( rtt > rtt_max )
+				rtt_max = rtt;
+		}
+
+		printf("%-28s : ",bench_settings[ux].name);
+		if ( lost >= n ) {
+			printf("no replies\n");
+			continue;
+		}
+		wire_ms = double(tx.size() + b.length + 3) * cfg.char_bits() * 1e3 / cfg.baud;
+		printf("rtt %.3f ms (min %.3f max %.3f) less wire %.3f ms, ETX to user %.3f us",
+			double(rtt_sum) / (n - lost) / 1e6,
+			double(rtt_min) / 1e6,double(rtt_max) / 1e6,
+			double(rtt_sum) / (n - lost) / 1e6 - wire_ms,
+			double(user_sum) / (n - lost) / 1e3);
+		printf("%s%s",pkt.config().low_latency_ok() ? "" : " [no ASYNC_LOW_LATENCY]",
+			pkt.config().ftdi_latency_ok() ? "" : " [no FTDI timer]");
+		if ( lost )
+			printf(" lost %d",lost);
+		putchar('\n');
+		fflush(stdout);
+	}
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Decode benchmark
+//
+// Frame the whole source into memory, then time n passes of decoding
+// its 84, 56, 6D and 5A reports: per packet through RxPacket::get()
+// into arrays of records, and in one RptBatch::decode() call into
+// columns. Both must find the same reports; the column sums check
+// that they found the same values. Then the 84 and 56 reports are
+// decoded by get_fixed(), and each scaled integer is compared with
+// the float path's value, rounded.
+//////////////////////////////////////////////////////////////////////
+
+static unsigned
+fx_error(int32_t fx,double ref,double k) {
+	double d = double(fx) - ref * k;
+
+	if ( d < 0 )
+		d = -d;
+	return d < 1e9 ? unsigned(d + 0.5) : ~0u;
+}
+
+static int
+decode_bench(Packet& pkt,int n) {
+	std::vector<uint8_t> store;
+	std::vector<unsigned> starts;
+	std::vector<s_pktref> refs;
+	uint8_t *packet = 0;
+	int pktlen;
+	bool ended;
+	unsigned x, np, rows[4];
+	RxPacket rxpkt;
+	RptBatch batch;
+	uint64_t t0, t_get, t_batch;
+	double sum_get = 0.0, sum_batch = 0.0;
+
+	for (;;) {
+		pkt.get(&packet,&pktlen,ended);
+		if ( pktlen <= 0 )
 			break;
-		case 0x4A :
-			{
-				s_R4A r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  latitude    %f\n",r.latitude);
-					printf("  longitude   %f\n",r.longitude);
-					printf("  altitude    %f\n",r.altitude);
-					printf("  clock bias  %f\n",r.clock_bias);
-					if ( !rxpkt.is_double() )
-						printf("  time of fix %f\n",r.u.time_of_fix1);
-					else	printf("  time of fix %lf\n",r.u.time_of_fix2);
-				}
+		if ( !ended )
+			continue;
+		starts.push_back(store.size());
+		store.insert(store.end(),packet,packet + pktlen);
+	}
+	starts.push_back(store.size());
+	np = starts.size() - 1;
+	refs.resize(np);
+	for ( x=0; x<np; ++x ) {
+		refs[x].data = store.data() + starts[x];
+		refs[x].length = starts[x+1] - starts[x];
+	}
+	if ( !np ) {
+		fprintf(stderr,"No packets to decode.\n");
+		return 1;
+	}
+
+	std::vector<s_R84> r84(np);
+	std::vector<s_R56> r56(np);
+	std::vector<s_R6D> r6D(np);
+	std::vector<s_R5A> r5A(np);
+
+	t0 = mono_ns();
+	for ( int pass=0; pass<n; ++pass ) {
+		rows[0] = rows[1] = rows[2] = rows[3] = 0;
+		for ( x=0; x<np; ++x ) {
+			rxpkt.load(store.data() + starts[x],refs[x].length);
+			switch ( rxpkt.id() ) {
+			case 0x84 :
+				rows[0] += rxpkt.get(r84[rows[0]]);
+				break;
+			case 0x56 :
+				rows[1] += rxpkt.get(r56[rows[1]]);
+				break;
+			case 0x6D :
+				rows[2] += rxpkt.get(r6D[rows[2]]);
+				break;
+			case 0x5A :
+				rows[3] += rxpkt.get(r5A[rows[3]]);
+				break;
 			}
-			break;
-		case 0x4B :
-			{
-				s_R4B r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  machine_id         = %02X\n",r.machine_id);
-					printf("  almanac incomplete = %d\n",r.u1.status1.almanac_incomplete);
-					printf("  super packets      = %02X\n",r.status2);
-				}
+		}
+	}
+	t_get = mono_ns() - t0;
+
+	batch.open(np);
+	t0 = mono_ns();
+	for ( int pass=0; pass<n; ++pass ) {
+		batch.clear();
+		batch.decode(refs.data(),np);
+	}
+	t_batch = mono_ns() - t0;
+
+	for ( x=0; x<rows[0]; ++x )
+		sum_get += r84[x].altitude;
+	for ( x=0; x<rows[1]; ++x )
+		sum_get += r56[x].upvel;
+	for ( x=0; x<rows[2]; ++x )
+		sum_get += r6D[x].pdop;
+	for ( x=0; x<rows[3]; ++x )
+		sum_get += r5A[x].doppler;
+	for ( x=0; x<batch.rows84(); ++x )
+		sum_batch += batch.cols84().altitude[x];
+	for ( x=0; x<batch.rows56(); ++x )
+		sum_batch += batch.cols56().upvel[x];
+	for ( x=0; x<batch.rows6D(); ++x )
+		sum_batch += batch.cols6D().pdop[x];
+	for ( x=0; x<batch.rows5A(); ++x )
+		sum_batch += batch.cols5A().doppler[x];
+
+	printf("%u packets, %u bytes: 84 x %u, 56 x %u, 6D x %u, 5A x %u, %lu others\n",
+		np,unsigned(store.size()),rows[0],rows[1],rows[2],rows[3],batch.others());
+	printf("  RxPacket::get    %8.1f ns/packet\n",double(t_get) / n / np);
+	printf("  RptBatch::decode %8.1f ns/packet\n",double(t_batch) / n / np);
+
+	std::vector<s_R84fx> f84(np);
+	std::vector<s_R56fx> f56(np);
+	unsigned nf84 = 0, nf56 = 0, err, worst[3] = { 0, 0, 0 };
+	const double rad_deg7 = 180.0 / M_PI * 1e7;
+
+	t0 = mono_ns();
+	for ( int pass=0; pass<n; ++pass ) {
+		nf84 = nf56 = 0;
+		for ( x=0; x<np; ++x ) {
+			rxpkt.load(store.data() + starts[x],refs[x].length);
+			switch ( rxpkt.id() ) {
+			case 0x84 :
+				nf84 += get_fixed(rxpkt,f84[nf84]);
+				break;
+			case 0x56 :
+				nf56 += get_fixed(rxpkt,f56[nf56]);
+				break;
 			}
+		}
+	}
+	t_get = mono_ns() - t0;
+
+	for ( x=0; x<nf84 && x<rows[0]; ++x ) {
+		if ( (err = fx_error(f84[x].latitude,r84[x].latitude,rad_deg7)) > worst[0] )
+			worst[0] = err;
+		if ( (err = fx_error(f84[x].longitude,r84[x].longitude,rad_deg7)) > worst[0] )
+			worst[0] = err;
+		if ( (err = fx_error(f84[x].altitude,r84[x].altitude,1e3)) > worst[1] )
+			worst[1] = err;
+		if ( (err = fx_error(f84[x].time_of_fix,r84[x].u.time_of_fix1,1e3)) > worst[1] )
+			worst[1] = err;
+	}
+	for ( x=0; x<nf56 && x<rows[1]; ++x ) {
+		if ( (err = fx_error(f56[x].eastvel,r56[x].eastvel,1e2)) > worst[2] )
+			worst[2] = err;
+		if ( (err = fx_error(f56[x].northvel,r56[x].northvel,1e2)) > worst[2] )
+			worst[2] = err;
+		if ( (err = fx_error(f56[x].upvel,r56[x].upvel,1e2)) > worst[2] )
+			worst[2] = err;
+		if ( (err = fx_error(f56[x].time_of_fix,r56[x].u.time_of_fix1,1e3)) > worst[1] )
+			worst[1] = err;
+	}
+	printf("  get_fixed 84, 56 %8.1f ns/packet, worst error: %u x 1e-7 deg, %u mm/ms, %u cm/s\n",
+		double(t_get) / n / np,worst[0],worst[1],worst[2]);
+	if ( nf84 != rows[0] || nf56 != rows[1] || worst[0] > 1 || worst[1] > 1 || worst[2] > 1 ) {
+		printf("  MISMATCH: fixed point\n");
+		return 1;
+	}
+	if ( rows[0] != batch.rows84() || rows[1] != batch.rows56()
+	  || rows[2] != batch.rows6D() || rows[3] != batch.rows5A()
+	  || sum_get != sum_batch ) {
+		printf("  MISMATCH: sums %.17g and %.17g\n",sum_get,sum_batch);
+		return 1;
+	}
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Report display, one overload per hand written record in TSIP_REPORTS
+//////////////////////////////////////////////////////////////////////
+
+static void
+show(const s_RxUnknown& u,RxPacket& rxpkt) {
+	puts(" ???");
+}
+
+static void
+show(const s_RxError& e,RxPacket& rxpkt) {
+	printf(" ERR %d\n",e.offset);
+}
+
+static void
+show(const s_R1C81& r,RxPacket& rxpkt) {
+	printf("  firmware     %u.%u build %u\n",r.major_firm,r.minor_firm,r.build_no);
+	printf("  date         %04d-%02u-%02u\n",r.year,r.month,r.day);
+	printf("  product      %.*s\n",r.length,(const char *)r.prodname);
+}
+
+static void
+show(const s_R1C83& r,RxPacket& rxpkt) {
+	printf("  serial no    %u\n",r.serialno);
+	printf("  build date   %04u-%02u-%02u %02u h\n",r.year,r.month,r.day,r.hour);
+	printf("  hardw code   %u\n",r.hardw_code);
+	printf("  hardw id     %.*s\n",r.length,(const char *)r.hardw_id);
+}
+
+static void
+show(const s_R3D& r,RxPacket& rxpkt) {
+	printf("  output baud  = %u\n",s_R3D::baud_rate(r.output_baud_rate));
+	printf("  input baud   = %u\n",s_R3D::baud_rate(r.input_baud_rate));
+	printf("  parity_bits  = %02X\n",r.parity_bits);
+	printf("  stop_flow    = %02X\n",r.stop_flow);
+	printf("  out_protocol = %u\n",r.out_protocol);
+	printf("  in_protocol  = %u\n",r.in_protocol);
+}
+
+static void
+show(const s_R40& r,RxPacket& rxpkt) {
+	printf("  satellite = %u\n",r.satellite);
+	printf("  t_zc      = %f\n",r.t_zc);
+	printf("  week_no   = %d\n",r.week_no);
+	printf("  eccentricity = %f\n",r.eccentricity);
+	printf("  t_oa      = %f\n",r.t_oa);
+	printf("  i_o       = %f\n",r.i_o);
+	printf("  omega_dot = %f\n",r.omega_dot);
+	printf("  sqrt_a    = %f\n",r.sqrt_a);
+	printf("  omega_o   = %f\n",r.omega_o);
+	printf("  omega     = %f\n",r.omega);
+	printf("  m_o       = %f\n",r.m_o);
+}
+
+static void
+show(const s_R41& r,RxPacket& rxpkt) {
+	printf("  time      = %f\n",r.time);
+	printf("  week      = %d\n",r.week);
+	printf("  offset    = %f\n",r.offset);
+}
+
+static void
+show(const s_R42& r,RxPacket& rxpkt) {
+	printf("  X = %f\n",r.x);
+	printf("  Y = %f\n",r.y);
+	printf("  Z = %f\n",r.z);
+	if ( !rxpkt.is_double() )
+		printf("  t = %f GPS secs\n",r.u.time_of_fix1);
+	else 	printf("  t = %lf GPS secs\n",r.u.time_of_fix2);
+}
+
+static void
+show(const s_R43& r,RxPacket& rxpkt) {
+	printf("  x_velocity = %f\n",r.x_velocity);
+	printf("  y_velocity = %f\n",r.y_velocity);
+}
+
+static void
+show(const s_R45& r,RxPacket& rxpkt) {
+	printf("  nav proc  %u.%02u %02u/%02u/%u\n",r.major,r.minor,r.month,r.day,1900+r.year);
+	printf("  sig proc  %u.%02u %02u/%02u/%u\n",r.major2,r.minor2,r.month2,r.day2,1900+r.year2);
+}
+
+static void
+show(const s_R46& r,RxPacket& rxpkt) {
+	printf("  status = %d\n",int(r.status));
+	switch ( r.status ) {
+	case DoingPositionFixes	:
+		puts("  (Doing position fixes)");
+		break;
+	case DoNotHaveGPSTimeYet :
+		puts("  (Do not have GPS time yet)");
+		break;
+	case PDOPIsTooHigh :
+		puts("  (PDOP is too high)");
+		break;
+	case NoUsableSatellites	:
+		puts("  (No usable satellites)");
+		break;
+	case Only1UsableSat :
+		puts("  (Only 1 usable satellite)");
+		break;
+	case Only2UsableSats :
+		puts("  (Only 2 usable satellites)");
+		break;
+	case Only3UsableSats :
+		puts("  (Only 3 usable satellites)");
+		break;
+	case ChosenSatIsUnusable :
+		puts("  (Chosen satellite is unusable)");
+		break;
+	default :
+		;		
+	};
+	printf("  error_code = %02X\n",r.u.error_code);
+	printf("    bat failed = %d\n",r.u.flags.battery_failed);
+	printf("    ant fault  = %d\n",r.u.flags.antenna_fault);
+	printf("    exc errors = %d\n",r.u.flags.excessive_errs);
+}
+
+static void
+show(const s_R47& r,RxPacket& rxpkt) {
+	printf("  count = %u\n",r.count);
+	for ( unsigned ux=0; ux<r.count; ++ux ) {
+		printf("    %02X level %.lf\n",
+			r.sat[ux].prn,
+			r.sat[ux].siglevel);
+	}
+}
+
+static void
+show(const s_R48& r,RxPacket& rxpkt) {
+	printf(" message: %-22.22s\n",r.message);
+}
+
+static void
+show(const s_R49& r,RxPacket& rxpkt) {
+	for ( short x=0; x<32; ++x )
+		printf("  %2d : %02X\n",x,r.health[x]);
+}
+
+static void
+show(const s_R4A& r,RxPacket& rxpkt) {
+	printf("  latitude    %f\n",r.latitude);
+	printf("  longitude   %f\n",r.longitude);
+	printf("  altitude    %f\n",r.altitude);
+	printf("  clock bias  %f\n",r.clock_bias);
+	if ( !rxpkt.is_double() )
+		printf("  time of fix %f\n",r.u.time_of_fix1);
+	else	printf("  time of fix %lf\n",r.u.time_of_fix2);
+}
+
+static void
+show(const s_R4B& r,RxPacket& rxpkt) {
+	printf("  machine_id         = %02X\n",r.machine_id);
+	printf("  almanac incomplete = %d\n",r.u1.status1.almanac_incomplete);
+	printf("  super packets      = %02X\n",r.status2);
+}
+
+static void
+show(const s_R4C& r,RxPacket& rxpkt) {
+	printf("  dynamics code     = %u\n",r.dynamics_code);
+	printf("  elevation mask    = %f\n",r.elevation_mask);
+	printf("  signal level mask = %f\n",r.signal_level_mask);
+	printf("  PDOP mask         = %f\n",r.pdop_mask);
+	printf("  PDOP switch       = %f\n",r.podp_switch);
+}
+
+static void
+show(const s_R4D& r,RxPacket& rxpkt) {
+	printf("  oscillator offset %f Hz\n",r.offset);
+}
+
+static void
+show(const s_R4E& r,RxPacket& rxpkt) {
+	printf("  Response '%c'\n",r.yn);
+}
+
+static void
+show(const s_R4F& r,RxPacket& rxpkt) {
+	printf("  a0          %lf\n",r.a0);
+	printf("  a1          %f\n",r.a1);
+	printf("  delta t_ls  %d\n",r.delta_t_ls);
+	printf("  tot         %f\n",r.tot);
+	printf("  wn_t        %d\n",r.wn_t);
+	printf("  wn_lsf      %d\n",r.wn_lsf);
+	printf("  dn          %d\n",r.dn);
+	printf("  delta t_lsf %d\n",r.delta_t_lsf);
+}
+
+static void
+show(const s_R54& r,RxPacket& rxpkt) {
+	printf("  bias         %f\n",r.bias);
+	printf("  bias rate    %f\n",r.bias_rate);
+	if ( !rxpkt.is_double() )
+		printf("  time of fix  %f\n",r.u.time_of_fix1);
+	else	printf("  time of fix  %lf\n",r.u.time_of_fix2);
+}
+
+static void
+show(const s_R55& r,RxPacket& rxpkt) {
+	printf("  position  %02X\n",r.position);
+	printf("  velocity  %02X\n",r.velocity);
+	printf("  timing    %02X\n",r.timing);
+	printf("  auxiliary %02X\n",r.auxiliary);
+}
+
+static void
+show(const s_R56& r,RxPacket& rxpkt) {
+	printf("  East velocity   %f\n",r.eastvel);
+	printf("  North velocity  %f\n",r.northvel);
+	printf("  Up velocity     %f\n",r.upvel);
+	printf("  Clock bias rate %f\n",r.clock_bias_rate);
+	if ( !rxpkt.is_double() )
+		printf("  Time of fix     %f\n",r.u.time_of_fix1);
+	else	printf("  Time of fix     %lf\n",r.u.time_of_fix2);
+}
+
+static void
+show(const s_R57& r,RxPacket& rxpkt) {
+	printf("  info src         %02X (%s)\n",r.info_src,
+		!r.info_src ? "none" : "regular fix");
+	printf("  tracking mode    %02X ",r.track_mode);
+	switch ( r.track_mode ) {
+	case 0 :
+		puts("auto");
+		break;
+	case 1 :
+		puts("time only 1-SV");
+		break;
+	case 2 :
+		puts("2D clock hold");
+		break;
+	case 3 :
+		puts("2D");
+		break;
+	case 4 :
+		puts("3D");
+		break;
+	case 5 :
+		puts("overdetermined clock");
+		break;
+	case 6 :
+		puts("DGPS reference");
+		break;
+	default :
+		printf("??\n");
+	}
+	printf("  time of last fix  %f\n",r.fix_time);
+	printf("  week of last fix  %d\n",r.fix_week);
+}
+
+static void
+show(const s_R58& r,RxPacket& rxpkt) {
+	printf("  operation = %02X\n",r.operation);
+	printf("  datatype  = %d\n",r.datatype);
+	printf("  sv_prn    = %u\n",r.sv_prn);
+	printf("  length    = %u\n",r.n);
+	if ( r58_wire_size(r.datatype) )
+		printf("  records   = %u\n",r.n / r58_wire_size(r.datatype));
+}
+
+static void
+show(const s_R59& r,RxPacket& rxpkt) {
+	printf("  operation = %02X\n",r.operation);
+	for ( short x=0; x<32; ++x )
+		printf("  %2d : %02X\n",x+1,r.sv_flags[x]);
+}
+
+static void
+show(const s_R5A& r,RxPacket& rxpkt) {
+	printf("  Satellite PRN  %u\n",r.sv_prn);
+	printf("  Sample length  %f ms\n",r.samplength);
+	printf("  Signal level   %f AMUs\n",r.siglevel);
+	printf("  Code phase     %f\n",r.code_phase);
+	printf("  Doppler        %f Hz\n",r.doppler);
+	printf("  Time           %lf seconds\n",r.time);
+}
+
+static void
+show(const s_R5B& r,RxPacket& rxpkt) {
+	printf("  sv_prn        = %02X\n",r.sv_prn);
+	printf("  coltime       = %f\n",r.coltime);
+	printf("  health        = %02X\n",r.health);
+	printf("  iode          = %02X\n",r.iode);
+	printf("  t_oe          = %f secs\n",r.t_oe);
+	printf("  fit_ival_flag = %02X\n",r.fit_ival_flag);
+	printf("  ura           = %f m\n",r.ura);
+}
+
+static void
+show(const s_R5C& r,RxPacket& rxpkt) {
+	printf("  Satellite PRN  %u\n",r.sv_prn);
+	printf("  Channel/slot   %02X\n",r.chan_slot);
+	printf("  Acquisition    %u\n",r.aquisflag);
+	printf("  Ephemeris      %u\n",r.ephemflag);
+	printf("  Signal level   %f AMUs\n",r.siglevel);
+	printf("  GPS time       %f\n",r.gps_time);
+	printf("  Elevation      %f\n",r.elevation);
+	printf("  Azimuth        %f\n",r.azimuth);
+}
+
+static void
+show(const s_R5F11& r,RxPacket& rxpkt) {
+	printf("  status        = %02X\n",r.status);
+}
+
+static void
+show(const s_R6D& r,RxPacket& rxpkt) {
+	printf("  fixmod = %02X\n",r.fixmode);
+	printf("  PDOP   = %f\n",r.pdop);
+	printf("  HDOP   = %f\n",r.hdop);
+	printf("  VDOP   = %f\n",r.vdop);
+	printf("  TDOP   = %f\n",r.tdop);
+	for ( uint8_t ux=0; ux<r.n; ++ux ) {
+		printf("  SVPRN[%u] = %02X\n",ux,r.sv_prn[ux]);
+	}
+}
+
+static void
+show(const s_R82& r,RxPacket& rxpkt) {
+	printf("  mode      = %d\n",r.mode);
+}
+
+static void
+show(const s_R83& r,RxPacket& rxpkt) {
+	printf("  x            %lf\n",r.x);
+	printf("  y            %lf\n",r.y);
+	printf("  z            %lf\n",r.z);
+	printf("  clock bias   %lf\n",r.clock_bias);
+	if ( !rxpkt.is_double() )
+		printf("  time of fix  %f\n",r.u.time_of_fix1);
+	else	printf("  time of fix  %lf\n",r.u.time_of_fix2);
+}
+
+static void
+show(const s_R84& r,RxPacket& rxpkt) {
+	printf("  latitude     %lf\n",r.latitude);
+	printf("  longitude    %lf\n",r.longitude);
+	printf("  altitude     %lf\n",r.altitude);
+	printf("  clock bias   %lf\n",r.clock_bias);
+	if ( !rxpkt.is_double() )
+		printf("  time of fix  %f\n",r.u.time_of_fix1);
+	else	printf("  time of fix  %lf\n",r.u.time_of_fix2);
+}
+
+static void
+show(const s_R8F41& r,RxPacket& rxpkt) {
+	printf("  serial no  %d-%u\n",r.serprefix,r.serialno);
+	printf("  built      %02u/%02u/%02u %02u h\n",r.year,r.month,r.day,r.hour);
+	printf("  osc offset %f\n",r.oscoffset);
+	printf("  test code  %d\n",r.testcode);
+}
+
+static void
+show(const s_R8F42& r,RxPacket& rxpkt) {
+	printf("  options    %02X-%02X\n",r.optsprefix,r.pnextension);
+	printf("  case ser   %d-%u\n",r.csnpref,r.caseser);
+	printf("  product no %u\n",r.prodno);
+	printf("  machine id %d\n",r.machid);
+}
+
+static void
+show(const s_R8FA5& r,RxPacket& rxpkt) {
+	printf("  x8F20     = %d\n",r.u.x8F20);
+	printf("  auto_tsip = %d\n",r.u.auto_tsip);
+	printf("  x8FAB     = %d\n",r.u.x8FAB);
+	printf("  x8FAC     = %d\n",r.u.x8FAC);
+	printf("  x8F0B_sya = %d\n",r.u.x8F0B_sya);
+	printf("  x8F0B_eva = %d\n",r.u.x8F0B_eva);
+	printf("  x8F0B_evb = %d\n",r.u.x8F0B_evb);
+	printf("  x8F0B_syb = %d\n",r.u.x8F0B_syb);
+	printf("  x8FAD_eva = %d\n",r.u.x8FAD_eva);
+	printf("  x8FAD_syb = %d\n",r.u.x8FAD_syb);
+	printf("  x8FAD_evb = %d\n",r.u.x8FAD_evb);
+}
+
+static void
+show(const s_R8FAB& r,RxPacket& rxpkt) {
+	printf("  time of week %llu\n",(unsigned long long)r.tow);
+	printf("  week no      %u\n",r.weekno);
+	printf("  UTC offset   %d\n",r.utc_offset);
+	printf("  timing flags %02X\n",r.timing_flags.raw);
+	printf("  %04u-%02u-%02u %02u:%02u:%02u\n",r.year,r.month,r.mday,r.hours,r.minutes,r.seconds);
+}
+
+static void
+show(const s_RBB00& r,RxPacket& rxpkt) {
+	printf("  opdim        = %u\n",r.opdim);
+	printf("  dgps_mode    = %u\n",r.dgps_mode);
+	printf("  dyn_mode     = %u\n",r.dyn_mode);
+	printf("  sol_mode     = %u\n",r.sol_mode);
+	printf("  elev_mask    = %f\n",r.elev_mask);
+	printf("  amu_mask     = %f\n",r.amu_mask);
+	printf("  pdop_mask    = %f\n",r.pdop_mask);
+	printf("  pdop_switch  = %f\n",r.pdop_switch);
+	printf("  dgps_age     = %u\n",r.dgps_age);
+	printf("  foliage_mode = %u\n",r.foliage_mode);
+	printf("  meas_rate    = %u\n",r.meas_rate);
+	printf("  posfx_rate   = %u\n",r.posfx_rate);
+}
+
+// Reports decoded by rgen's decoders (rlist.h) have no display of their own
+template <class R>
+static void
+show(const R& r,RxPacket& rxpkt) {
+	printf("  %s: %u bytes decoded\n",MsgId<R>::name,rxpkt.get_offset());
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// Open a packet source (see Transport::create())
+//////////////////////////////////////////////////////////////////////
+
+static Transport *
+open_transport(const char *spec,const SerialConfig& serial) {
+	Transport *t = Transport::create(spec,&serial);
+
+	if ( !t ) {
+		fprintf(stderr,"%s: %s\n",spec,strerror(errno));
+		exit(1);
+	}
+	if ( !strcmp(t->kind(),"pty") )
+		fprintf(stderr,"Pseudo terminal: %s\n",t->name());
+	return t;
+}
+
+static void
+usage(const char *cmd) {
+	fprintf(stderr,
+		"Usage: %s [-F] [-T] [-U] [-t] [-L] [-B n] [-D n] [-d dev] [-b baud[,8O1]] [-u baud] [-g ms] [-s scanner] [source]\n"
+		"\t-F\t\tFrame only, report framing throughput\n"
+		"\t-T\t\tReceive in a reader thread\n"
+		"\t-U\t\tSimulate the AVR build: play source into a UART\n"
+		"\t\t\t  receive ISR at the -b rate (no commands)\n"
+		"\t-B n\t\tBenchmark serial latency settings (n round trips)\n"
+		"\t-D n\t\tBenchmark decoding source (n passes), per packet\n"
+		"\t\t\t  versus batched into columns\n"
+		"\t-d dev\t\tReceiver (serial device, or a source below)\n"
+		"\t-b spec\t\tSerial settings (default 9600,8O1)\n"
+		"\t-u baud\t\tSwitch receiver and port to baud (38400, 57600, 115200)\n"
+		"\t-g ms\t\tGap ending a partial packet (0=none, default 250)\n"
+		"\t-s scanner\tDLE scanner: scalar, sse2 or avx2\n"
+		"\t-t\t\tShow packet arrival times\n"
+		"\t-L\t\tAccept any packet length (no msgs.dat length rules)\n"
+		"\tsource\t\tRead packet data only (no commands) from:\n"
+		"\t\t\t  - (stdin), a device or capture file path, tty:path,\n"
+		"\t\t\t  file:path, pty:, tcp:host:port, tcp-listen:[host:]port\n"
+		"\t\t\t  or unix:path\n",
+		cmd);
+	exit(2);
+}
+
+int
+main(int argc,char **argv) {
+	PacketPool pool;		// Must outlive pkt and pp
+	Packet pkt;
+	PooledPacket pp;
+	CmdChannel cmdchan;		// Commands from stdin
+	RxThread rxthread;		// -T reader
+	HostUart upkt;			// -U receiver
+	UartSim uartsim;		// -U receive "ISR"
+	Transport *usrc = 0;		// -U source
+	RxThread::s_rxslot *batch = 0;	// Slots taken from rxthread
+	unsigned nbatch = 0, nextslot = 0;
+	RxPacket rxpkt;
+	uint8_t *packet = 0;
+	int pktlen;
+	bool ended;
+	const s_pktstamp *stamp;
+	int rc;
+	std::unordered_set<uint8_t> idset;
+	bool opt_frame = false;
+	bool opt_thread = false;
+	bool opt_uart = false;
+	bool opt_cmds = false;
+	bool opt_time = false;
+	int opt_bench = 0;
+	int opt_decode = 0;
+	unsigned opt_baud = 0;
+	const char *opt_dev = 0;
+	SerialConfig serial;
+	int opt_gap = 250;
+	bool opt_lenrules = true;
+	int optch;
+
+	while ( (optch = getopt(argc,argv,"FTUB:D:d:b:u:g:s:tLh")) != -1 ) {
+		switch ( optch ) {
+		case 'F' :
+			opt_frame = true;
 			break;
-		case 0x4E :
-			{
-				s_R4E r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  Response '%c'\n",r.yn);
-				}
-			}
+		case 'T' :
+			opt_thread = true;
 			break;
-		case 0x4F :
-			{
-				s_R4F r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  a0          %lf\n",r.a0);
-					printf("  a1          %f\n",r.a1);
-					printf("  delta t_ls  %d\n",r.delta_t_ls);
-					printf("  tot         %f\n",r.tot);
-					printf("  wn_t        %d\n",r.wn_t);
-					printf("  wn_lsf      %d\n",r.wn_lsf);
-					printf("  dn          %d\n",r.dn);
-					printf("  delta t_lsf %d\n",r.delta_t_lsf);
-				}
-			}
+		case 'U' :
+			opt_uart = true;
 			break;
-		case 0x54 :
-			{
-				s_R54 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  bias         %f\n",r.bias);
-					printf("  bias rate    %f\n",r.bias_rate);
-					if ( !rxpkt.is_double() )
-						printf("  time of fix  %f\n",r.u.time_of_fix1);
-					else	printf("  time of fix  %lf\n",r.u.time_of_fix2);
-				}
-			}
+		case 'B' :
+			opt_bench = atoi(optarg);
+			if ( opt_bench <= 0 )
+				usage(argv[0]);
 			break;
-		case 0x55 :
-			{
-				s_R55 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  position  %02X\n",r.position);
-					printf("  velocity  %02X\n",r.velocity);
-					printf("  timing    %02X\n",r.timing);
-					printf("  auxiliary %02X\n",r.auxiliary);
-				}
-			}
+		case 'D' :
+			opt_decode = atoi(optarg);
+			if ( opt_decode <= 0 )
+				usage(argv[0]);
 			break;
-		case 0x56 :
-			{
-				s_R56 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  East velocity   %f\n",r.eastvel);
-					printf("  North velocity  %f\n",r.northvel);
-					printf("  Up velocity     %f\n",r.upvel);
-					printf("  Clock bias rate %f\n",r.clock_bias_rate);
-					if ( !rxpkt.is_double() )
-						printf("  Time of fix     %f\n",r.u.time_of_fix1);
-					else	printf("  Time of fix     %lf\n",r.u.time_of_fix2);
-				}
-			}
+		case 'd' :
+			opt_dev = optarg;
 			break;
-		case 0x57 :
-			{
-				s_R57 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  info src         %02X (%s)\n",r.info_src,
-						!r.info_src ? "none" : "regular fix");
-					printf("  tracking mode    %02X ",r.track_mode);
-					switch ( r.track_mode ) {
-					case 0 :
-						puts("auto");
-						break;
-					case 1 :
-						puts("time only 1-SV");
-						break;
-					case 2 :
-						puts("2D clock hold");
-						break;
-					case 3 :
-						puts("2D");
-						break;
-					case 4 :
-						puts("3D");
-						break;
-					case 5 :
-						puts("overdetermined clock");
-						break;
-					case 6 :
-						puts("DGPS reference");
-						break;
-					default :
-						printf("??\n");
-					}
-					printf("  time of last fix  %f\n",r.fix_time);
-					printf("  week of last fix  %d\n",r.fix_week);
-				}
+		case 'b' :
+			if ( !serial.parse(optarg) ) {
+				fprintf(stderr,"Bad serial settings: %s\n",optarg);
+				exit(1);
 			}
 			break;
-		case 0x5A :
-			{
-				s_R5A r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  Satellite PRN  %u\n",r.sv_prn);
-					printf("  Sample length  %f ms\n",r.samplength);
-					printf("  Signal level   %f AMUs\n",r.siglevel);
-					printf("  Code phase     %f\n",r.code_phase);
-					printf("  Doppler        %f Hz\n",r.doppler);
-					printf("  Time           %lf seconds\n",r.time);
-				}
-			}
-			break;			
-		case 0x5B :
-			{
-				s_R5B r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  sv_prn        = %02X\n",r.sv_prn);
-					printf("  coltime       = %f\n",r.coltime);
-					printf("  health        = %02X\n",r.health);
-					printf("  iode          = %02X\n",r.iode);
-					printf("  t_oe          = %f secs\n",r.t_oe);
-					printf("  fit_ival_flag = %02X\n",r.fit_ival_flag);
-					printf("  ura           = %f m\n",r.ura);
-				}
+		case 'u' :
+			opt_baud = strtoul(optarg,0,10);
+			if ( !s_R3D::baud_code(opt_baud) || !SerialConfig::valid_baud(opt_baud) ) {
+				fprintf(stderr,"Unsupported baud rate: %s\n",optarg);
+				exit(1);
 			}
 			break;
-		case 0x5F11 :
-			{
-				s_R5F11 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  status        = %02X\n",r.status);
-				}
-			}
+		case 'g' :
+			opt_gap = atoi(optarg);
 			break;
-		case 0x6D :
-			{
-				s_R6D r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  fixmod = %02X\n",r.fixmode);
-					printf("  PDOP   = %f\n",r.pdop);
-					printf("  HDOP   = %f\n",r.hdop);
-					printf("  VDOP   = %f\n",r.vdop);
-					printf("  TDOP   = %f\n",r.tdop);
-					for ( uint8_t ux=0; ux<r.n; ++ux ) {
-						printf("  SVPRN[%u] = %02X\n",ux,r.sv_prn[ux]);
-					}
-				}
-			}
+		case 't' :
+			opt_time = true;
 			break;
-		case 0x82 :
-			{
-				s_R82 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  mode      = %d\n",r.mode);
-				}
-			}
+		case 'L' :
+			opt_lenrules = false;
 			break;
-		case 0x83 :
-			{
-				s_R83 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  x            %lf\n",r.x);
-					printf("  y            %lf\n",r.y);
-					printf("  z            %lf\n",r.z);
-					printf("  clock bias   %lf\n",r.clock_bias);
-					if ( !rxpkt.is_double() )
-						printf("  time of fix  %f\n",r.u.time_of_fix1);
-					else	printf("  time of fix  %lf\n",r.u.time_of_fix2);
-				}
+		case 's' :
+			if ( !strcmp(optarg,"scalar") )
+				rc = dle_scan_select(dle_scalar);
+			else if ( !strcmp(optarg,"sse2") )
+				rc = dle_scan_select(dle_sse2);
+			else if ( !strcmp(optarg,"avx2") )
+				rc = dle_scan_select(dle_avx2);
+			else	usage(argv[0]);
+			if ( !rc ) {
+				fprintf(stderr,"Scanner %s is not supported.\n",optarg);
+				exit(1);
 			}
 			break;
-		case 0x84 :
-			{
-				s_R84 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  latitude     %lf\n",r.latitude);
-					printf("  longitude    %lf\n",r.longitude);
-					printf("  altitude     %lf\n",r.altitude);
-					printf("  clock bias   %lf\n",r.clock_bias);
-					if ( !rxpkt.is_double() )
-						printf("  time of fix  %f\n",r.u.time_of_fix1);
-					else	printf("  time of fix  %lf\n",r.u.time_of_fix2);
+		default :
+			usage(argv[0]);
+		}
+	}
+
+	if ( !opt_dev )
+		opt_dev = "/dev/cu.usbserial-A100MX3L";
+
+	if ( opt_uart && (opt_frame || opt_thread || opt_bench || opt_decode || opt_baud) )
+		usage(argv[0]);			// -U has no Packet
+
+	if ( opt_bench > 0 ) {
+		pkt.open(open_transport(optind < argc ? argv[optind] : opt_dev,serial));
+		return benchmark(pkt,opt_bench);
+	}
+
+	if ( opt_uart ) {
+		usrc = open_transport(optind < argc ? argv[optind] : opt_dev,serial);
+		if ( opt_lenrules )
+			upkt.setrule(tsip_length_rule);
+		if ( !uartsim.start(usrc->fd(),serial.baud,serial.char_bits(),uart_isr,&upkt) ) {
+			fprintf(stderr,"UART simulation: %s\n",strerror(errno));
+			exit(1);
+		}
+	} else if ( optind >= argc ) {
+		pkt.open(open_transport(opt_dev,serial));
+		opt_cmds = pkt.fd() != 0;	// Unless stdin is the receiver
+
+		rc = opt_cmds ? tcgetattr(0,&tios) : 0;
+		sv_tios = tios;
+		assert(!rc);
+		cfmakeraw(&tios);
+		tios.c_oflag |= OPOST | ONLCR;
+		rc = opt_cmds ? tcsetattr(0,TCSANOW,&tios) : 0;
+		assert(!rc);
+		if ( opt_cmds )
+			atexit(restore_tty);
+	} else	{
+		pkt.open(open_transport(optind < argc ? argv[optind] : opt_dev,serial));
+	}
+
+	pkt.set_gap_timeout(opt_gap);
+	pkt.set_length_rules(opt_lenrules);
+
+	if ( opt_baud ) {
+		if ( pkt.set_baud(opt_baud) )
+			fprintf(stderr,"Switched to %u baud.\r\n",opt_baud);
+		else	fprintf(stderr,"Baud rate switch failed, staying at %u.\r\n",
+				pkt.config().baud);
+	}
+
+	if ( opt_cmds && !pipe(quit_pipe) )
+		pkt.set_cancel(quit_pipe[0]);
+	if ( opt_cmds && (quit_pipe[0] < 0 || !cmdchan.start(pkt,cmdcb)) ) {
+		fprintf(stderr,"Command channel: %s\r\n",strerror(errno));
+		exit(1);
+	}
+
+	if ( opt_frame )
+		return frame_only(pkt);
+	if ( opt_decode > 0 )
+		return decode_bench(pkt,opt_decode);
+
+	if ( opt_thread ) {
+		if ( !rxthread.start(pkt) ) {
+			fprintf(stderr,"Reader thread: %s\n",strerror(errno));
+			exit(1);
+		}
+	} else if ( !opt_uart ) {
+		pool.open(4,1024);
+		pkt.setpool(&pool);
+	}
+
+	for (;;) {
+		fflush(stdout);
+		fflush(stderr);
+		if ( opt_thread ) {
+			if ( nextslot >= nbatch ) {
+				rxthread.release(nbatch);
+				nbatch = nextslot = 0;
+				if ( rxthread.wait() < 0 ) {
+					puts("<EOF>");
+					break;
 				}
+				nbatch = rxthread.take(&batch);
 			}
-			break;
-		case 0x8FA5 :
-			{
-				s_R8FA5 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  x8F20     = %d\n",r.u.x8F20);
-					printf("  auto_tsip = %d\n",r.u.auto_tsip);
-					printf("  x8FAB     = %d\n",r.u.x8FAB);
-					printf("  x8FAC     = %d\n",r.u.x8FAC);
-					printf("  x8F0B_sya = %d\n",r.u.x8F0B_sya);
-					printf("  x8F0B_eva = %d\n",r.u.x8F0B_eva);
-					printf("  x8F0B_evb = %d\n",r.u.x8F0B_evb);
-					printf("  x8F0B_syb = %d\n",r.u.x8F0B_syb);
-					printf("  x8FAD_eva = %d\n",r.u.x8FAD_eva);
-					printf("  x8FAD_syb = %d\n",r.u.x8FAD_syb);
-					printf("  x8FAD_evb = %d\n",r.u.x8FAD_evb);
-				}
+			RxThread::s_rxslot& slot = batch[nextslot++];
+
+			packet = slot.data;
+			pktlen = slot.length;
+			ended = slot.ended;
+			stamp = &slot.stamp;
+		} else if ( opt_uart ) {
+			if ( !uart_get(upkt,uartsim,&packet,&pktlen,ended) ) {
+				puts("<EOF>");
+				break;
 			}
-			break;			
-		case 0xBB00 :
-			{
-				s_RBB00 r;
-				if ( !rxpkt.get(r) ) {
-					printf(" ERR %d\n",rxpkt.get_offset());
-				} else	{
-					printf("  opdim        = %u\n",r.opdim);
-					printf("  dgps_mode    = %u\n",r.dgps_mode);
-					printf("  dyn_mode     = %u\n",r.dyn_mode);
-					printf("  sol_mode     = %u\n",r.sol_mode);
-					printf("  elev_mask    = %f\n",r.elev_mask);
-					printf("  amu_mask     = %f\n",r.amu_mask);
-					printf("  pdop_mask    = %f\n",r.pdop_mask);
-					printf("  pdop_switch  = %f\n",r.pdop_switch);
-					printf("  dgps_age     = %u\n",r.dgps_age);
-					printf("  foliage_mode = %u\n",r.foliage_mode);
-					printf("  meas_rate    = %u\n",r.meas_rate);
-					printf("  posfx_rate   = %u\n",r.posfx_rate);
-				}
+			stamp = 0;		// An MCU has no clock to spare
+		} else	{
+			pp.release();
+			if ( !pkt.get(pp) ) {
+				puts("<EOF>");
+				break;
 			}
-			break;
-		default :
+			packet = pp.data();
+			pktlen = pp.size();
+			ended = pp.is_ended();
+			stamp = &pp.stamp();
+		}
+		flockfile(stdout);		// Keep command output out of it
+		dump(packet,pktlen,ended);
+		if ( opt_time && stamp )
+			tdump(*stamp);
+
+		rxpkt.load(packet,pktlen);
+		RxReport rpt = decode(rxpkt);
+
+		if ( std::holds_alternative<s_RxUnknown>(rpt) ) {
 			idset.insert(packet[0]);
 			puts(" ???");
-		}
+		} else	std::visit([&rxpkt](const auto& r) { show(r,rxpkt); },rpt);
+		funlockfile(stdout);
 	}
 
 	//////////////////////////////////////////////////////////////
@@ -704,6 +1366,18 @@ main(int argc,char **argv) {
 		printf("ID %02X\n",id);
 	}
 
+	cmdchan.stop();
+	if ( opt_thread ) {
+		rxthread.stop();
+		rxstats(rxthread);
+	}
+	if ( opt_uart ) {
+		uartsim.stop();
+		uartstats(upkt,uartsim);
+		delete usrc;
+		return 0;
+	}
+	iostats(pkt);
 	return 0;
 }
 
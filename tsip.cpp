@@ -8,9 +8,16 @@
 #include <unistd.h>
 #include <errno.h>
 #include <string.h>
+#include <stddef.h>
 #include <assert.h>
 
 #include "tsip.hpp"
+#include "layout.hpp"
+#include "beswap.hpp"
+
+const uint8_t tsip_super[256] = {
+#include "rsuper.h"
+};
 
 RxPacket::RxPacket() {
 	buf = 0;
@@ -35,19 +42,11 @@ RxPacket::id() {
 		return 0x10;		// No ID
 	if ( !get(id) )
 		return 0x10;
-
-	switch ( id ) {
-	case 0x5F :
-	case 0x8F :
-	case 0xBB :
-		if ( !get(sub) )
-			return 0x10;
-		return (uint16_t(id) << 8) | uint16_t(sub);
-		break;
-	default :
-		break;
-	}
-	return id;
+	if ( !tsip_super[id] )
+		return id;
+	if ( !get(sub) )
+		return 0x10;
+	return (uint16_t(id) << 8) | uint16_t(sub);
 }
 
 bool
@@ -60,192 +59,201 @@ RxPacket::get(uint8_t& byte) {
 
 uint16_t
 RxPacket::get(uint8_t *buf,uint16_t count) {
-	uint16_t rcount = 0;
+	uint16_t rcount = offset < length ? length - offset : 0;
 
-	for ( ; count > 0 && offset < length; --count, ++rcount )
-		*buf++ = this->buf[offset++];
+	if ( count < rcount )
+		rcount = count;
+	memcpy(buf,this->buf + offset,rcount);
+	offset += rcount;
 	return rcount;
 }
 
 bool
 RxPacket::get(int16_t& ival) {
-	uint8_t bytes[2];
+	const uint8_t *p = fixed(sizeof ival);
 
-	if ( get(bytes,2) != 2 )
+	if ( !p )
 		return false;
-	ival = ((short)bytes[0] << 8) | (short)bytes[1];
+	ival = be_load<int16_t>(p);
 	return true;
 }
 
 bool
 RxPacket::get(uint16_t& uval) {
-	uint8_t bytes[2];
+	const uint8_t *p = fixed(sizeof uval);
 
-	if ( get(bytes,2) != 2 )
+	if ( !p )
 		return false;
-	uval = ((uint16_t)bytes[0] << 8) | (uint16_t)bytes[1];
+	uval = be_load<uint16_t>(p);
 	return true;
 }
 
 bool
 RxPacket::get(int32_t& ival) {
-	uint8_t bytes[4];
+	const uint8_t *p = fixed(sizeof ival);
 
-	if ( get(bytes,4) != 4 )
+	if ( !p )
 		return false;
-	
-	ival	= ((int)bytes[0] << 24)
-		| ((int)bytes[1] << 16)
-		| ((int)bytes[2] <<  8)
-		| ((int)bytes[3]);
+	ival = be_load<int32_t>(p);
 	return true;
 }
 
 bool
 RxPacket::get(uint32_t& uval) {
-	uint8_t bytes[4];
+	const uint8_t *p = fixed(sizeof uval);
 
-	if ( get(bytes,4) != 4 )
+	if ( !p )
 		return false;
-	
-	uval	= ((uint32_t)bytes[0] << 24)
-		| ((uint32_t)bytes[1] << 16)
-		| ((uint32_t)bytes[2] <<  8)
-		| ((uint32_t)bytes[3]);
+	uval = be_load<uint32_t>(p);
 	return true;
 }
 
 bool
 RxPacket::get(int64_t& ival) {
-	int32_t i32;
-
-	if ( !get(i32) )
-		return false;
+	const uint8_t *p = fixed(sizeof ival);
 
-	ival = (int64_t)i32 << 32;
-	if ( !get(i32) )
+	if ( !p )
 		return false;
-	ival |= i32;
+	ival = be_load<int64_t>(p);
 	return true;
 }
 
 bool
 RxPacket::get(uint64_t& uval) {
-	uint32_t u32;
-
-	if ( !get(u32) )
-		return false;
+	const uint8_t *p = fixed(sizeof uval);
 
-	uval = (uint64_t)u32 << 32;
-	if ( !get(u32) )
+	if ( !p )
 		return false;
-	uval |= u32;
+	uval = be_load<uint64_t>(p);
 	return true;
 }
 
 bool
 RxPacket::get(float& fval) {
-	union	{
-		int32_t	i32;
-		float	f32;
-	} u;
+	const uint8_t *p = fixed(sizeof fval);
 
-	if ( !get(u.i32) )
+	if ( !p )
 		return false;
-	fval = u.f32;
+	fval = be_load<float>(p);
 	return true;
 }
 
 bool
 RxPacket::get(double& fval) {
-	union	{
-		int64_t	i64;
-		double	f64;
-	} u;
+	const uint8_t *p = fixed(sizeof fval);
 
-	if ( !get(u.i64) )
+	if ( !p )
 		return false;
-	fval = u.f64;
+	fval = be_load<double>(p);
 	return true;
 }
 
 bool
-RxPacket::get(s_R40& recd) {
-	
-	if ( !get(recd.satellite) )
-		return false;
-	if ( !get(recd.t_zc) )
-		return false;
-	if ( !get(recd.week_no) )
-		return false;
-	if ( !get(recd.eccentricity) )
-		return false;
-	if ( !get(recd.t_oa) )
-		return false;
-	if ( !get(recd.i_o) )
-		return false;
-	if ( !get(recd.omega_dot) )
-		return false;
-	if ( !get(recd.sqrt_a) )
-		return false;
-	if ( !get(recd.omega_o) )
-		return false;
-	if ( !get(recd.omega) )
-		return false;
-	if ( !get(recd.m_o) )
+RxPacket::get(s_R3D& recd) {
+	typedef Layout<s_R3D> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
 		return false;
+	recd.output_baud_rate = L::output_baud_rate::load(p);
+	recd.input_baud_rate = L::input_baud_rate::load(p);
+	recd.parity_bits = L::parity_bits::load(p);
+	recd.stop_flow = L::stop_flow::load(p);
+	recd.out_protocol = L::out_protocol::load(p);
+	recd.in_protocol = L::in_protocol::load(p);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Baud rate codes used by 3D
+//////////////////////////////////////////////////////////////////////
+
+static const unsigned baud_codes[] = {
+	0, 0, 0, 0, 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200
+};
+
+uint8_t
+s_R3D::baud_code(unsigned baud) {
+
+	for ( uint8_t ux=0; ux<sizeof baud_codes/sizeof baud_codes[0]; ++ux )
+		if ( baud && baud_codes[ux] == baud )
+			return ux;
+	return 0;
+}
+
+unsigned
+s_R3D::baud_rate(uint8_t code) {
+
+	if ( code >= sizeof baud_codes/sizeof baud_codes[0] )
+		return 0;
+	return baud_codes[code];
+}
+
+bool
+RxPacket::get(s_R40& recd) {
+	typedef Layout<s_R40> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.satellite = L::satellite::load(p);
+	recd.t_zc = L::t_zc::load(p);
+	recd.week_no = L::week_no::load(p);
+	recd.eccentricity = L::eccentricity::load(p);
+	recd.t_oa = L::t_oa::load(p);
+	recd.i_o = L::i_o::load(p);
+	recd.omega_dot = L::omega_dot::load(p);
+	recd.sqrt_a = L::sqrt_a::load(p);
+	recd.omega_o = L::omega_o::load(p);
+	recd.omega = L::omega::load(p);
+	recd.m_o = L::m_o::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R41& recd) {
-	if ( !get(recd.time) )
-		return false;
-	if ( !get(recd.week) )
-		return false;
-	if ( !get(recd.offset) )
+	typedef Layout<s_R41> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
 		return false;
+	recd.time = L::time::load(p);
+	recd.week = L::week::load(p);
+	recd.offset = L::offset::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R42& recd) {
-	if ( !get(recd.x) )
-		return false;
-	if ( !get(recd.y) )
-		return false;
-	if ( !get(recd.z) )
-		return false;
-
-	if ( !state_sd ) {
-		if ( !get(recd.u.time_of_fix1) )
-			return false;
-	} else	{
-		if ( !get(recd.u.time_of_fix2) )
-			return false;
-	}
+	typedef Layout<s_R42> L;
+	const uint8_t *p = fixed(L::size,L::size_sd);
 
+	if ( !p )
+		return false;
+	recd.x = L::x::load(p);
+	recd.y = L::y::load(p);
+	recd.z = L::z::load(p);
+	if ( !state_sd )
+		recd.u.time_of_fix1 = L::time_of_fix1::load(p);
+	else	recd.u.time_of_fix2 = L::time_of_fix2::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R43& recd) {
+	typedef Layout<s_R43> L;
+	unsigned n;
+	const uint8_t *p = partial(L::min,L::size,L::size_sd,n);
 
-	if ( !get(recd.x_velocity) )
+	if ( !p )
 		return false;
-	if ( !get(recd.y_velocity) )
-		return false;
-	if ( !get(recd.z_velocity) )
-		recd.z_velocity = 0.0;
-	if ( !get(recd.bias_rate) )
-		recd.bias_rate = 0.0;
-	if ( state_sd ) {
-		if ( !get(recd.u.time_of_fix1) )
-			recd.u.time_of_fix1 = 0.0;
-	} else	{
-		if ( !get(recd.u.time_of_fix2) )
-			recd.u.time_of_fix2 = 0.0;
-	}
+	recd.x_velocity = L::x_velocity::load(p);
+	recd.y_velocity = L::y_velocity::load(p);
+	recd.z_velocity = n >= L::z_velocity::end ? L::z_velocity::load(p) : 0.0;
+	recd.bias_rate = n >= L::bias_rate::end ? L::bias_rate::load(p) : 0.0;
+	if ( !state_sd )
+		recd.u.time_of_fix1 = n >= L::time_of_fix1::end ? L::time_of_fix1::load(p) : 0.0;
+	else	recd.u.time_of_fix2 = n >= L::time_of_fix2::end ? L::time_of_fix2::load(p) : 0.0;
 	return true;
 }
 
@@ -283,23 +291,19 @@ RxPacket::get(s_R49& recd) {
 
 bool
 RxPacket::get(s_R4A& recd) {
+	typedef Layout<s_R4A> L;
+	unsigned n;
+	const uint8_t *p = partial(L::min,L::size,L::size_sd,n);
 
-	if ( !get(recd.latitude) )
+	if ( !p )
 		return false;
-	if ( !get(recd.longitude) )
-		return false;
-	if ( !get(recd.altitude) )
-		recd.altitude = 0;
-	if ( !get(recd.clock_bias) )
-		recd.clock_bias = 0;
-
-	if ( state_sd ) {
-		if ( !get(recd.u.time_of_fix1) )
-			recd.u.time_of_fix1 = 0.0;
-	} else	{
-		if ( !get(recd.u.time_of_fix2) )
-			recd.u.time_of_fix2 = 0.0;
-	}
+	recd.latitude = L::latitude::load(p);
+	recd.longitude = L::longitude::load(p);
+	recd.altitude = n >= L::altitude::end ? L::altitude::load(p) : 0;
+	recd.clock_bias = n >= L::clock_bias::end ? L::clock_bias::load(p) : 0;
+	if ( !state_sd )
+		recd.u.time_of_fix1 = n >= L::time_of_fix1::end ? L::time_of_fix1::load(p) : 0.0;
+	else	recd.u.time_of_fix2 = n >= L::time_of_fix2::end ? L::time_of_fix2::load(p) : 0.0;
 	return true;
 }
 
@@ -317,40 +321,48 @@ RxPacket::get(s_R4B& recd) {
 
 bool
 RxPacket::get(s_R4C& recd) {
+	typedef Layout<s_R4C> L;
+	const uint8_t *p = fixed(L::size);
 
-	if ( !get(recd.dynamics_code) )
-		return false;
-	if ( !get(recd.elevation_mask) )
-		return false;
-	if ( !get(recd.signal_level_mask) )
+	if ( !p )
 		return false;
-	if ( !get(recd.pdop_mask) )
-		return false;		
-	if ( !get(recd.podp_switch) )
-		return false;
-	return 0;
+	recd.dynamics_code = L::dynamics_code::load(p);
+	recd.elevation_mask = L::elevation_mask::load(p);
+	recd.signal_level_mask = L::signal_level_mask::load(p);
+	recd.pdop_mask = L::pdop_mask::load(p);
+	recd.podp_switch = L::podp_switch::load(p);
+	return true;
 }
 
 bool
 RxPacket::get(s_R56& recd) {
+	typedef Layout<s_R56> L;
+	const uint8_t *p = fixed(L::size,L::size_sd);
 
-	if ( !get(recd.eastvel)
-	  || !get(recd.northvel)
-	  || !get(recd.upvel)
-	  || !get(recd.clock_bias_rate) )
-	  	return false;
-
+	if ( !p )
+		return false;
+	recd.eastvel = L::eastvel::load(p);
+	recd.northvel = L::northvel::load(p);
+	recd.upvel = L::upvel::load(p);
+	recd.clock_bias_rate = L::clock_bias_rate::load(p);
 	if ( !state_sd )
-		return get(recd.u.time_of_fix1);
-	return get(recd.u.time_of_fix2);
+		recd.u.time_of_fix1 = L::time_of_fix1::load(p);
+	else	recd.u.time_of_fix2 = L::time_of_fix2::load(p);
+	return true;
 }
 
 bool
 RxPacket::get(s_R57& recd) {
-	return !get(recd.info_src)
-	  || !get(recd.track_mode)
-	  || !get(recd.fix_time)
-	  || !get(recd.fix_week);
+	typedef Layout<s_R57> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.info_src = L::info_src::load(p);
+	recd.track_mode = L::track_mode::load(p);
+	recd.fix_time = L::fix_time::load(p);
+	recd.fix_week = L::fix_week::load(p);
+	return true;
 }
 
 bool
@@ -368,53 +380,47 @@ RxPacket::get(s_R59& recd) {
 
 bool
 RxPacket::get(s_R5A& recd) {
+	typedef Layout<s_R5A> L;
+	const uint8_t *p = fixed(L::size);
 
-	if ( !get(recd.sv_prn) )
-		return false;
-	if ( !get(recd.samplength) )
-		return false;
-	if ( !get(recd.siglevel) )
-		return false;
-	if ( !get(recd.code_phase) )
-		return false;
-	if ( !get(recd.doppler) )
-		return false;
-	if ( !get(recd.time) )
+	if ( !p )
 		return false;
+	recd.sv_prn = L::sv_prn::load(p);
+	be_floats(&recd.samplength,p + L::samplength::offset,4);
+	recd.time = L::time::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R5B& recd) {
-	if ( !get(recd.sv_prn) )
-		return false;
-	if ( !get(recd.coltime) )
-		return false;
-	if ( !get(recd.health) )
-		return false;
-	if ( !get(recd.iode) )
-		return false;
-	if ( !get(recd.t_oe) )
-		recd.t_oe = 0.0;
-	if ( !get(recd.fit_ival_flag) )
-		recd.fit_ival_flag = 0;
-	if ( !get(recd.ura) )
-		recd.ura = 0.0;
+	typedef Layout<s_R5B> L;
+	unsigned n;
+	const uint8_t *p = partial(L::min,L::size,L::size,n);
+
+	if ( !p )
+		return false;
+	recd.sv_prn = L::sv_prn::load(p);
+	recd.coltime = L::coltime::load(p);
+	recd.health = L::health::load(p);
+	recd.iode = L::iode::load(p);
+	recd.t_oe = n >= L::t_oe::end ? L::t_oe::load(p) : 0.0;
+	recd.fit_ival_flag = n >= L::fit_ival_flag::end ? L::fit_ival_flag::load(p) : 0;
+	recd.ura = n >= L::ura::end ? L::ura::load(p) : 0.0;
 	return true;
 }
 
 bool
 RxPacket::get(s_R6D& recd) {
-	if ( !get(recd.fixmode) )
-		return false;
-	if ( !get(recd.pdop) )
-		return false;
-	if ( !get(recd.hdop) )
-		return false;
-	if ( !get(recd.vdop) )
-		return false;
-	if ( !get(recd.tdop) )
+	typedef Layout<s_R6D> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
 		return false;
+	recd.fixmode = L::fixmode::load(p);
+	recd.pdop = L::pdop::load(p);
+	recd.hdop = L::hdop::load(p);
+	recd.vdop = L::vdop::load(p);
+	recd.tdop = L::tdop::load(p);
 
 	memset(recd.sv_prn,0,sizeof recd.sv_prn);
 	recd.n = get(recd.sv_prn,sizeof recd.sv_prn);
@@ -441,457 +447,470 @@ RxPacket::get(s_R82& recd) {
 
 bool
 RxPacket::get(s_R47& recd) {
+	typedef Layout<s_R47> L;
+	typedef L::sat S;
+	const uint8_t *p = fixed(L::size);
+	unsigned n, avail;
+	bool whole = true;
 
-	if ( !get(recd.count) )
+	if ( !p )
 		return false;
+	recd.count = L::count::load(p);
 
-	for ( uint16_t x=0; x<recd.count && x < 12; ++x ) {
-		if ( !get(recd.sat[x].prn) || !get(recd.sat[x].siglevel) ) {
-			recd.count = x;
-			return false;
-		}
+	n = recd.count < 12 ? recd.count : 12;
+	avail = (length - offset) / S::size;
+	if ( avail < n ) {
+		recd.count = n = avail;		// Keep the whole records
+		whole = false;
 	}
-	return true;
+
+	// Siglevels are interleaved with PRNs: no run to convert in bulk
+	p = fixed(n * S::size);
+	for ( unsigned x=0; x<n; ++x, p += S::size ) {
+		recd.sat[x].prn = S::prn::load(p);
+		recd.sat[x].siglevel = S::siglevel::load(p);
+	}
+	return whole;
 }
 
 bool
 RxPacket::get(s_R4D& recd) {
-	return get(recd.offset);
+	typedef Layout<s_R4D> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.offset = L::offset::load(p);
+	return true;
 }
 
 bool
 RxPacket::get(s_R4E& recd) {
-	return get(recd.yn);
+	typedef Layout<s_R4E> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.yn = L::yn::load(p);
+	return true;
 }
 
 
 bool
 RxPacket::get(s_R4F& recd) {
-
-	if ( !get(recd.a0) )
-		return false;
-	if ( !get(recd.a1) )
-		return false;
-	if ( !get(recd.delta_t_ls) )
-		return false;
-	if ( !get(recd.tot) )
-		return false;
-	if ( !get(recd.wn_t) )
-		return false;
-	if ( !get(recd.wn_lsf) )
-		return false;
-	if ( !get(recd.dn) )
-		return false;
-	if ( !get(recd.delta_t_lsf) )
-		return false;
+	typedef Layout<s_R4F> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.a0 = L::a0::load(p);
+	recd.a1 = L::a1::load(p);
+	recd.delta_t_ls = L::delta_t_ls::load(p);
+	recd.tot = L::tot::load(p);
+	recd.wn_t = L::wn_t::load(p);
+	recd.wn_lsf = L::wn_lsf::load(p);
+	recd.dn = L::dn::load(p);
+	recd.delta_t_lsf = L::delta_t_lsf::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R54& recd) {
+	typedef Layout<s_R54> L;
+	const uint8_t *p = fixed(L::size,L::size_sd);
 
-	if ( !get(recd.bias) )
-		return false;
-	if ( !get(recd.bias_rate) )
+	if ( !p )
 		return false;
-	if ( state_sd ) {
-		if ( !get(recd.u.time_of_fix1) )
-			return false;
-	} else	{
-		if ( !get(recd.u.time_of_fix2) )
-			return false;
-	}
+	recd.bias = L::bias::load(p);
+	recd.bias_rate = L::bias_rate::load(p);
+	if ( !state_sd )
+		recd.u.time_of_fix1 = L::time_of_fix1::load(p);
+	else	recd.u.time_of_fix2 = L::time_of_fix2::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R55& recd) {
+	typedef Layout<s_R55> L;
+	const uint8_t *p = fixed(L::size);
 
-	if ( !get(recd.position) )
-		return false;
-	if ( !get(recd.velocity) )
-		return false;
-	if ( !get(recd.timing) )
-		return false;
-	if ( !get(recd.auxiliary) )
+	if ( !p )
 		return false;
+	recd.position = L::position::load(p);
+	recd.velocity = L::velocity::load(p);
+	recd.timing = L::timing::load(p);
+	recd.auxiliary = L::auxiliary::load(p);
 	return true;
 }
 
-bool
-RxPacket::get(s_R58& recd) {
-	uint8_t typ;
+//////////////////////////////////////////////////////////////////////
+// Satellite system data: each record is checked against the packet
+// length once, and its runs of floats and doubles are converted by
+// the bulk kernels (the asserts keep struct and wire runs in step)
+//////////////////////////////////////////////////////////////////////
+
+#define RUN_OF(S,first,last,T,n)					\
+	static_assert(offsetof(S,last) - offsetof(S,first) == (n - 1) * sizeof(T) \
+	  && Layout<S>::last::offset - Layout<S>::first::offset == (n - 1) * sizeof(T), \
+	  #S " " #first " to " #last " is not a run of " #n " " #T "s")
+
+RUN_OF(s_R58::s_almanac,e,t_zc,float,15);
+RUN_OF(s_R58::s_ionosphere,alpha_0,beta_3,float,8);
+RUN_OF(s_R58::s_ephemeris,t_gd,svacc,float,6);
+RUN_OF(s_R58::s_ephemeris,axis,odot_n,double,5);
+RUN_OF(s_R5A,samplength,doppler,float,4);
 
-	if ( !get(recd.operation) )
-		return false;
-	if ( !get(typ) )
-		return false;
-	recd.datatype = s_R58::Type(typ);
-	if ( !get(recd.sv_prn) )
-		return false;
-	if ( !get(recd.n) )
-		return false;
+#undef RUN_OF
 
-	switch ( recd.datatype ) {
-	case s_R58::NotUsed :
-		break;
+static_assert(r58_wire_size(s_R58::Almanac) == Layout<s_R58::s_almanac>::size
+  && r58_wire_size(s_R58::Health) == Layout<s_R58::s_health>::size
+  && r58_wire_size(s_R58::Ionosphere) == Layout<s_R58::s_ionosphere>::size
+  && r58_wire_size(s_R58::UTC) == Layout<s_R58::s_utc>::size
+  && r58_wire_size(s_R58::Ephemeris) == Layout<s_R58::s_ephemeris>::size,
+  "r58_wire_size() disagrees with the 58 record layouts");
+
+static void
+r58_decode(s_R58::s_almanac& r,const uint8_t *p) {
+	typedef Layout<s_R58::s_almanac> A;
+
+	r.t_oa_raw = A::t_oa_raw::load(p);
+	r.sv_health = A::sv_health::load(p);
+	be_floats(&r.e,p + A::e::offset,15);
+	r.weeknum = A::weeknum::load(p);
+	r.wn_oa = A::wn_oa::load(p);
+}
+
+static void
+r58_decode(s_R58::s_health& r,const uint8_t *p) {
+	typedef Layout<s_R58::s_health> H;
+
+	r.weekno = H::weekno::load(p);
+	H::sv_health::load(p,r.sv_health);
+	r.t_oa = H::t_oa::load(p);
+	r.cur_t_oa = H::cur_t_oa::load(p);
+	r.cur_weekno = H::cur_weekno::load(p);
+}
+
+static void
+r58_decode(s_R58::s_ionosphere& r,const uint8_t *p) {
+	typedef Layout<s_R58::s_ionosphere> I;
+
+	I::compressed::load(p,r.compressed);
+	be_floats(&r.alpha_0,p + I::alpha_0::offset,8);
+}
+
+static void
+r58_decode(s_R58::s_utc& r,const uint8_t *p) {
+	typedef Layout<s_R58::s_utc> U;
+
+	U::compressed::load(p,r.compressed);
+	r.a_0 = U::a_0::load(p);
+	r.a_1 = U::a_1::load(p);
+	r.delta_t_ls = U::delta_t_ls::load(p);
+	r.t_ot = U::t_ot::load(p);
+	r.wn_t = U::wn_t::load(p);
+	r.wn_lsf = U::wn_lsf::load(p);
+	r.dn = U::dn::load(p);
+	r.delta_t_lsf = U::delta_t_lsf::load(p);
+}
+
+static void
+r58_decode(s_R58::s_ephemeris& r,const uint8_t *p) {
+	typedef Layout<s_R58::s_ephemeris> E;
+
+	r.sv_prn = E::sv_prn::load(p);
+	r.t_ephem = E::t_ephem::load(p);
+	r.weekno = E::weekno::load(p);
+	r.codel2 = E::codel2::load(p);
+	r.l2pdata = E::l2pdata::load(p);
+	r.svacc_raw = E::svacc_raw::load(p);
+	r.sv_health = E::sv_health::load(p);
+	r.iodc = E::iodc::load(p);
+	be_floats(&r.t_gd,p + E::t_gd::offset,6);
+	r.iode = E::iode::load(p);
+	r.fit_ival = E::fit_ival::load(p);
+	r.c_rs = E::c_rs::load(p);
+	r.delta_n = E::delta_n::load(p);
+	r.m_0 = E::m_0::load(p);
+	r.c_uc = E::c_uc::load(p);
+	r.e = E::e::load(p);
+	r.c_us = E::c_us::load(p);
+	r.sqrt_a = E::sqrt_a::load(p);
+	r.t_oe = E::t_oe::load(p);
+	r.c_ic = E::c_ic::load(p);
+	r.omega_0 = E::omega_0::load(p);
+	r.c_is = E::c_is::load(p);
+	r.i_o = E::i_o::load(p);
+	r.c_rc = E::c_rc::load(p);
+	r.omega = E::omega::load(p);
+	r.omegadot = E::omegadot::load(p);
+	r.idot = E::idot::load(p);
+	be_doubles(&r.axis,p + E::axis::offset,5);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Decode count wire records of type at p into the array at to
+//////////////////////////////////////////////////////////////////////
+
+template <class R>
+static void
+r58_decode_all(void *to,const uint8_t *p,unsigned count) {
+	R *r = (R *)to;
+
+	for ( unsigned x=0; x<count; ++x, p += Layout<R>::size )
+		r58_decode(r[x],p);
+}
+
+static void
+r58_decode_all(s_R58::Type type,void *to,const uint8_t *p,unsigned count) {
+
+	switch ( type ) {
 	case s_R58::Almanac :
-		for ( uint8_t x=0; x<recd.n; ++x ) {
-			if ( !get(recd.u.s2.t_oa_raw) )
-				return false;
-			if ( !get(recd.u.s2.sv_health) )
-				return false;
-			if ( !get(recd.u.s2.e) )
-				return false;
-			if ( !get(recd.u.s2.t_oa) )
-				return false;
-			if ( !get(recd.u.s2.i_o) )
-				return false;
-			if ( !get(recd.u.s2.omegadot) )
-				return false;
-			if ( !get(recd.u.s2.sqrt_a) )
-				return false;
-			if ( !get(recd.u.s2.omega_0) )
-				return false;
-			if ( !get(recd.u.s2.omega) )
-				return false;
-			if ( !get(recd.u.s2.m_0) )
-				return false;
-			if ( !get(recd.u.s2.a_f0) )
-				return false;
-			if ( !get(recd.u.s2.a_f1) )
-				return false;
-			if ( !get(recd.u.s2.axis) )
-				return false;
-			if ( !get(recd.u.s2.n) )
-				return false;
-			if ( !get(recd.u.s2.omega_n) )
-				return false;
-			if ( !get(recd.u.s2.odot_n) )
-				return false;
-			if ( !get(recd.u.s2.t_zc) )
-				return false;
-			if ( !get(recd.u.s2.weeknum) )
-				return false;
-			if ( !get(recd.u.s2.wn_oa) )
-				return false;
-		}
+		r58_decode_all<s_R58::s_almanac>(to,p,count);
 		break;
 	case s_R58::Health :
-		for ( uint8_t x=0; x<recd.n; ++x ) {
-			if ( !get(recd.u.s3.weekno) )
-				return false;
-			if ( get(recd.u.s3.sv_health,32) != 32 )
-				return false;
-			if ( !get(recd.u.s3.t_oa) )
-				return false;
-			if ( !get(recd.u.s3.cur_t_oa) )
-				return false;
-			if ( !get(recd.u.s3.cur_weekno) )
-				return false;
-		}
+		r58_decode_all<s_R58::s_health>(to,p,count);
 		break;
 	case s_R58::Ionosphere :
-		for ( uint8_t x=0; x<recd.n; ++x ) {
-			if ( get(recd.u.s4.compressed,8) != 8 )
-				return false;
-			if ( !get(recd.u.s4.alpha_0) )
-				return false;
-			if ( !get(recd.u.s4.alpha_1) )
-				return false;
-			if ( !get(recd.u.s4.alpha_2) )
-				return false;
-			if ( !get(recd.u.s4.alpha_3) )
-				return false;
-			if ( !get(recd.u.s4.beta_0) )
-				return false;
-			if ( !get(recd.u.s4.beta_1) )
-				return false;
-			if ( !get(recd.u.s4.beta_2) )
-				return false;
-			if ( !get(recd.u.s4.beta_3) )
-				return false;
-		}
+		r58_decode_all<s_R58::s_ionosphere>(to,p,count);
 		break;
 	case s_R58::UTC :
-		for ( uint8_t x=0; x<recd.n; ++x ) {
-			if ( get(recd.u.s5.compressed,13) != 13 )
-				return false;
-			if ( !get(recd.u.s5.a_0) )
-				return false;
-			if ( !get(recd.u.s5.a_1) )
-				return false;
-			if ( !get(recd.u.s5.delta_t_ls) )
-				return false;
-			if ( !get(recd.u.s5.t_ot) )
-				return false;
-			if ( !get(recd.u.s5.wn_t) )
-				return false;
-			if ( !get(recd.u.s5.wn_lsf) )
-				return false;
-			if ( !get(recd.u.s5.dn) )
-				return false;
-			if ( !get(recd.u.s5.delta_t_lsf) )
-				return false;
-		}
+		r58_decode_all<s_R58::s_utc>(to,p,count);
 		break;
 	case s_R58::Ephemeris :
-		for ( uint8_t x=0; x<recd.n; ++x ) {
-			if ( !get(recd.u.s6.sv_prn) )
-				return false;
-			if ( !get(recd.u.s6.t_ephem) )
-				return false;
-			if ( !get(recd.u.s6.weekno) )
-				return false;
-			if ( !get(recd.u.s6.codel2) )
-				return false;
-			if ( !get(recd.u.s6.l2pdata) )
-				return false;
-			if ( !get(recd.u.s6.svacc_raw) )
-				return false;
-			if ( !get(recd.u.s6.sv_health) )
-				return false;
-			if ( !get(recd.u.s6.iodc) )
-				return false;
-			if ( !get(recd.u.s6.t_gd) )
-				return false;
-			if ( !get(recd.u.s6.t_oc) )
-				return false;
-			if ( !get(recd.u.s6.a_f2) )
-				return false;
-			if ( !get(recd.u.s6.a_f1) )
-				return false;
-			if ( !get(recd.u.s6.a_f0) )
-				return false;
-			if ( !get(recd.u.s6.svacc) )
-				return false;
-			if ( !get(recd.u.s6.iode) )
-				return false;
-			if ( !get(recd.u.s6.fit_ival) )
-				return false;
-			if ( !get(recd.u.s6.c_rs) )
-				return false;
-			if ( !get(recd.u.s6.delta_n) )
-				return false;
-			if ( !get(recd.u.s6.m_0) )
-				return false;
-			if ( !get(recd.u.s6.c_uc) )
-				return false;
-			if ( !get(recd.u.s6.e) )
-				return false;
-			if ( !get(recd.u.s6.c_us) )
-				return false;
-			if ( !get(recd.u.s6.sqrt_a) )
-				return false;
-			if ( !get(recd.u.s6.t_oe) )
-				return false;
-			if ( !get(recd.u.s6.c_ic) )
-				return false;
-			if ( !get(recd.u.s6.omega_0) )
-				return false;
-			if ( !get(recd.u.s6.c_is) )
-				return false;
-			if ( !get(recd.u.s6.i_o) )
-				return false;
-			if ( !get(recd.u.s6.c_rc) )
-				return false;
-			if ( !get(recd.u.s6.omega) )
-				return false;
-			if ( !get(recd.u.s6.omegadot) )
-				return false;
-			if ( !get(recd.u.s6.idot) )
-				return false;
-			if ( !get(recd.u.s6.axis) )
-				return false;
-			if ( !get(recd.u.s6.n) )
-				return false;
-			if ( !get(recd.u.s6.r1me2) )
-				return false;
-			if ( !get(recd.u.s6.omega_n) )
-				return false;
-			if ( !get(recd.u.s6.odot_n) )
-				return false;
-		}
+		r58_decode_all<s_R58::s_ephemeris>(to,p,count);
 		break;
 	default :
-		return false;
+		break;
 	}
-
-	return true;
 }
 
+//////////////////////////////////////////////////////////////////////
+// Header and first record (into u): n is the byte length of all the
+// records, which are skipped. Use get(s_R58set&,...) for them all.
+//////////////////////////////////////////////////////////////////////
+
 bool
-RxPacket::get(s_R5C& recd) {
+RxPacket::get(s_R58& recd) {
+	typedef Layout<s_R58> L;
+	const uint8_t *p = fixed(L::size);
+	unsigned wsize;
 
-	if ( !get(recd.sv_prn) )
-		return false;
-	if ( !get(recd.chan_slot) )
-		return false;
-	if ( !get(recd.aquisflag) )
-		return false;
-	if ( !get(recd.ephemflag) )
-		return false;
-	if ( !get(recd.siglevel) )
-		return false;
-	if ( !get(recd.gps_time) )
-		return false;
-	if ( !get(recd.elevation) )
+	if ( !p )
 		return false;
-	if ( !get(recd.azimuth) )
-		return false;
-	if ( !get(recd.oldmeas) )
-		return false;
-	if ( !get(recd.intmsec) )
+	recd.operation = L::operation::load(p);
+	recd.datatype = s_R58::Type(L::datatype::load(p));
+	recd.sv_prn = L::sv_prn::load(p);
+	recd.n = L::n::load(p);
+
+	if ( recd.datatype == s_R58::NotUsed )
+		return true;
+	if ( !(wsize = r58_wire_size(recd.datatype)) )
+		return false;			// Unknown datatype
+	if ( recd.n < wsize || !(p = fixed(recd.n / wsize * wsize)) )
 		return false;
-	if ( !get(recd.baddata) )
+	r58_decode_all(recd.datatype,&recd.u,p,1);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Header and every record, into arena (size bytes) as an array of the
+// datatype's struct. Records are whole: count stops short when the
+// packet ends early or the arena is full.
+//
+// RETURNS:
+//	true	- All n bytes of records decoded (count may be 0)
+//	false	- Short header, unknown datatype, or records lost
+//////////////////////////////////////////////////////////////////////
+
+bool
+RxPacket::get(s_R58set& recd,void *arena,size_t size) {
+	typedef Layout<s_R58> L;
+	const uint8_t *p = fixed(L::size);
+	uintptr_t a = (uintptr_t)arena, aligned;
+	unsigned wsize, want, avail, room;
+
+	recd.count = 0;
+	recd.rec.any = 0;
+	if ( !p )
 		return false;
-	if ( !get(recd.datacol) )
+	recd.operation = L::operation::load(p);
+	recd.datatype = s_R58::Type(L::datatype::load(p));
+	recd.sv_prn = L::sv_prn::load(p);
+	recd.n = L::n::load(p);
+
+	if ( recd.datatype == s_R58::NotUsed )
+		return true;
+	if ( !(wsize = r58_wire_size(recd.datatype)) )
 		return false;
+
+	aligned = (a + alignof(double) - 1) & ~uintptr_t(alignof(double) - 1);
+	want = recd.n / wsize;
+	avail = (length - offset) / wsize;
+	room = aligned - a < size ? (size - (aligned - a)) / r58_rec_size(recd.datatype) : 0;
+
+	recd.count = want;
+	if ( recd.count > avail )
+		recd.count = avail;
+	if ( recd.count > room )
+		recd.count = room;
+	recd.rec.any = (void *)aligned;
+
+	p = fixed(recd.count * wsize);
+	r58_decode_all(recd.datatype,recd.rec.any,p,recd.count);
+	return recd.count == want;
+}
+
+bool
+RxPacket::get(s_R5C& recd) {
+	typedef Layout<s_R5C> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.sv_prn = L::sv_prn::load(p);
+	recd.chan_slot = L::chan_slot::load(p);
+	recd.aquisflag = L::aquisflag::load(p);
+	recd.ephemflag = L::ephemflag::load(p);
+	recd.siglevel = L::siglevel::load(p);
+	recd.gps_time = L::gps_time::load(p);
+	recd.elevation = L::elevation::load(p);
+	recd.azimuth = L::azimuth::load(p);
+	recd.oldmeas = L::oldmeas::load(p);
+	recd.intmsec = L::intmsec::load(p);
+	recd.baddata = L::baddata::load(p);
+	recd.datacol = L::datacol::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R5F11& recd) {
-	return get(recd.status);
+	typedef Layout<s_R5F11> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.status = L::status::load(p);
+	return true;
 }
 
 bool
 RxPacket::get(s_R83& recd) {
+	typedef Layout<s_R83> L;
+	const uint8_t *p = fixed(L::size,L::size_sd);
 
-	if ( !get(recd.x) )
-		return false;
-	if ( !get(recd.y) )
-		return false;
-	if ( !get(recd.z) )
+	if ( !p )
 		return false;
-	if ( !get(recd.clock_bias) )
-		return false;
-	if ( state_sd ) {
-		if ( !get(recd.u.time_of_fix1) )
-			return false;
-	} else	{
-		if ( !get(recd.u.time_of_fix2) )
-			return false;
-	}
+	recd.x = L::x::load(p);
+	recd.y = L::y::load(p);
+	recd.z = L::z::load(p);
+	recd.clock_bias = L::clock_bias::load(p);
+	if ( !state_sd )
+		recd.u.time_of_fix1 = L::time_of_fix1::load(p);
+	else	recd.u.time_of_fix2 = L::time_of_fix2::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R84& recd) {
+	typedef Layout<s_R84> L;
+	const uint8_t *p = fixed(L::size,L::size_sd);
 
-	if ( !get(recd.latitude) )
-		return false;
-	if ( !get(recd.longitude) )
-		return false;
-	if ( !get(recd.altitude) )
+	if ( !p )
 		return false;
-	if ( !get(recd.clock_bias) )
-		return false;
-	if ( state_sd ) {
-		if ( !get(recd.u.time_of_fix1) )
-			return false;
-	} else	{
-		if ( !get(recd.u.time_of_fix2) )
-			return false;
-	}
-	return false;
+	recd.latitude = L::latitude::load(p);
+	recd.longitude = L::longitude::load(p);
+	recd.altitude = L::altitude::load(p);
+	recd.clock_bias = L::clock_bias::load(p);
+	if ( !state_sd )
+		recd.u.time_of_fix1 = L::time_of_fix1::load(p);
+	else	recd.u.time_of_fix2 = L::time_of_fix2::load(p);
+	return true;
 }
 
 bool
 RxPacket::get(s_R8F41& recd) {
-
-	if ( !get(recd.serprefix) )
-		return false;
-	if ( !get(recd.serialno) )
-		return false;
-	if ( !get(recd.year) )
-		return false;	
-	if ( !get(recd.month) )
-		return false;	
-	if ( !get(recd.day) )
-		return false;
-	if ( !get(recd.hour) )
-		return false;
-	if ( !get(recd.oscoffset) )
-		return false;
-	if ( !get(recd.testcode) )
-		return false;
+	typedef Layout<s_R8F41> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.serprefix = L::serprefix::load(p);
+	recd.serialno = L::serialno::load(p);
+	recd.year = L::year::load(p);
+	recd.month = L::month::load(p);
+	recd.day = L::day::load(p);
+	recd.hour = L::hour::load(p);
+	recd.oscoffset = L::oscoffset::load(p);
+	recd.testcode = L::testcode::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R8F42& recd) {
-
-	if ( !get(recd.optsprefix) )
-		return false;
-	if ( !get(recd.pnextension) )
-		return false;
-	if ( !get(recd.csnpref) )
-		return false;
-	if ( !get(recd.caseser) )
-		return false;
-	if ( !get(recd.prodno) )
-		return false;
-	if ( !get(recd.reserved1) )
-		return false;
-	if ( !get(recd.machid) )
-		return false;
-	if ( !get(recd.reserved2) )
-		return false;
+	typedef Layout<s_R8F42> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.optsprefix = L::optsprefix::load(p);
+	recd.pnextension = L::pnextension::load(p);
+	recd.csnpref = L::csnpref::load(p);
+	recd.caseser = L::caseser::load(p);
+	recd.prodno = L::prodno::load(p);
+	recd.reserved1 = L::reserved1::load(p);
+	recd.machid = L::machid::load(p);
+	recd.reserved2 = L::reserved2::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R8FA5& recd) {
-	return     get(recd.u.flags)
-		&& get(recd.mbz);
+	typedef Layout<s_R8FA5> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.u.flags = L::flags::load(p);
+	recd.mbz = L::mbz::load(p);
+	return true;
 }
 
 bool
 RxPacket::get(s_R8FAB& recd) {
-
-	if ( !get(recd.tow) )
-		return false;
-	if ( !get(recd.weekno) )
-		return false;
-	if ( !get(recd.utc_offset) )
-		return false;
-	if ( !get(recd.timing_flags.raw) )
-		return false;
-	if ( !get(recd.seconds) )
-		return false;
-	if ( !get(recd.minutes) )
-		return false;
-	if ( !get(recd.hours) )
-		return false;
-	if ( !get(recd.mday) )
-		return false;
-	if ( !get(recd.month) )
-		return false;
-	if ( !get(recd.year) )
-		return false;
+	typedef Layout<s_R8FAB> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.tow = L::tow::load(p);
+	recd.weekno = L::weekno::load(p);
+	recd.utc_offset = L::utc_offset::load(p);
+	recd.timing_flags.raw = L::timing_flags::load(p);
+	recd.seconds = L::seconds::load(p);
+	recd.minutes = L::minutes::load(p);
+	recd.hours = L::hours::load(p);
+	recd.mday = L::mday::load(p);
+	recd.month = L::month::load(p);
+	recd.year = L::year::load(p);
 	return true;
 }
 
 bool
 RxPacket::get(s_R1C81& recd) {
+	typedef Layout<s_R1C81> L;
+	const uint8_t *p = fixed(L::size);
 
-	if ( !get(recd.reserved1) )
-		return false;
-	if ( !get(recd.major_firm) )
-		return false;
-	if ( !get(recd.minor_firm) )
-		return false;
-	if ( !get(recd.build_no) )
-		return false;
-	if ( !get(recd.month) )
-		return false;
-	if ( !get(recd.day) )
-		return false;
-	if ( !get(recd.year) )
-		return false;
-	if ( !get(recd.length) )
+	if ( !p )
 		return false;
+	recd.reserved1 = L::reserved1::load(p);
+	recd.major_firm = L::major_firm::load(p);
+	recd.minor_firm = L::minor_firm::load(p);
+	recd.build_no = L::build_no::load(p);
+	recd.month = L::month::load(p);
+	recd.day = L::day::load(p);
+	recd.year = L::year::load(p);
+	recd.length = L::length::load(p);
 
 	uint16_t len = get(recd.prodname,sizeof recd.prodname);
 	if ( len > sizeof recd.prodname )
@@ -905,21 +924,18 @@ RxPacket::get(s_R1C81& recd) {
 
 bool
 RxPacket::get(s_R1C83& recd) {
+	typedef Layout<s_R1C83> L;
+	const uint8_t *p = fixed(L::size);
 
-	if ( !get(recd.serialno) )
-		return false;
-	if ( !get(recd.day) )
-		return false;
-	if ( !get(recd.month) )
-		return false;
-	if ( !get(recd.year) )
-		return false;
-	if ( !get(recd.hour) )
-		return false;
-	if ( !get(recd.hardw_code) )
-		return false;
-	if ( !get(recd.length) )
+	if ( !p )
 		return false;
+	recd.serialno = L::serialno::load(p);
+	recd.day = L::day::load(p);
+	recd.month = L::month::load(p);
+	recd.year = L::year::load(p);
+	recd.hour = L::hour::load(p);
+	recd.hardw_code = L::hardw_code::load(p);
+	recd.length = L::length::load(p);
 
 	uint16_t len = get(recd.hardw_id,sizeof recd.hardw_id);
 	if ( len > sizeof recd.hardw_id )
@@ -933,43 +949,46 @@ RxPacket::get(s_R1C83& recd) {
 
 bool
 RxPacket::get(s_R45& recd) {
-	if ( !get(recd.major) )
-		return false;
-	if ( !get(recd.minor) )
-		return false;
-	if ( !get(recd.month) )
-		return false;
-	if ( !get(recd.day) )
-		return false;
-	if ( !get(recd.year) )
-		return false;
-	if ( !get(recd.major2) )
-		return false;
-	if ( !get(recd.minor2) )
-		return false;
-	if ( !get(recd.month2) )
-		return false;
-	if ( !get(recd.day2) )
-		return false;
-	return get(recd.year2);
+	typedef Layout<s_R45> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.major = L::major::load(p);
+	recd.minor = L::minor::load(p);
+	recd.month = L::month::load(p);
+	recd.day = L::day::load(p);
+	recd.year = L::year::load(p);
+	recd.major2 = L::major2::load(p);
+	recd.minor2 = L::minor2::load(p);
+	recd.month2 = L::month2::load(p);
+	recd.day2 = L::day2::load(p);
+	recd.year2 = L::year2::load(p);
+	return true;
 }
 
 bool
 RxPacket::get(s_RBB00& recd) {
-	return     get(recd.opdim)
-		&& get(recd.dgps_mode)
-		&& get(recd.dyn_mode)
-		&& get(recd.sol_mode)
-		&& get(recd.elev_mask)
-		&& get(recd.amu_mask)
-		&& get(recd.pdop_mask)
-		&& get(recd.pdop_switch)
-		&& get(recd.dgps_age)
-		&& get(recd.foliage_mode)
-		&& get(recd.reserved1)
-		&& get(recd.reserved2)
-		&& get(recd.meas_rate)
-		&& get(recd.posfx_rate);
+	typedef Layout<s_RBB00> L;
+	const uint8_t *p = fixed(L::size);
+
+	if ( !p )
+		return false;
+	recd.opdim = L::opdim::load(p);
+	recd.dgps_mode = L::dgps_mode::load(p);
+	recd.dyn_mode = L::dyn_mode::load(p);
+	recd.sol_mode = L::sol_mode::load(p);
+	recd.elev_mask = L::elev_mask::load(p);
+	recd.amu_mask = L::amu_mask::load(p);
+	recd.pdop_mask = L::pdop_mask::load(p);
+	recd.pdop_switch = L::pdop_switch::load(p);
+	recd.dgps_age = L::dgps_age::load(p);
+	recd.foliage_mode = L::foliage_mode::load(p);
+	recd.reserved1 = L::reserved1::load(p);
+	recd.reserved2 = L::reserved2::load(p);
+	recd.meas_rate = L::meas_rate::load(p);
+	recd.posfx_rate = L::posfx_rate::load(p);
+	return true;
 }
 
 
@@ -1521,6 +1540,36 @@ TxPacket::C3C(uint8_t prn) {
 		&& close();
 }
 
+//////////////////////////////////////////////////////////////////////
+// 3D	-- Serial Port Configuration Request
+// Response:
+//	R3D
+//////////////////////////////////////////////////////////////////////
+
+bool
+TxPacket::C3D() {
+	return command(0x3D) && close();
+}
+
+//////////////////////////////////////////////////////////////////////
+// 3D	-- Set Serial Port Configuration
+// The receiver switches after replying at the old settings.
+// Response:
+//	R3D
+//////////////////////////////////////////////////////////////////////
+
+bool
+TxPacket::C3D(s_R3D& parms) {
+	return command(0x3D)
+		&& put(parms.output_baud_rate)
+		&& put(parms.input_baud_rate)
+		&& put(parms.parity_bits)
+		&& put(parms.stop_flow)
+		&& put(parms.out_protocol)
+		&& put(parms.in_protocol)
+		&& close();
+}
+
 //////////////////////////////////////////////////////////////////////
 // 3F11	-- EEPROM Segment Commands
 // Response:
@@ -7,6 +7,39 @@
 #define TSIP_HPP
 
 #include <stdint.h>
+#include <stddef.h>
+
+//////////////////////////////////////////////////////////////////////
+// Response 3D : Serial Port A Configuration (also C3D)
+//////////////////////////////////////////////////////////////////////
+
+struct s_R3D {
+	enum Baud {
+		Baud1200	= 4,
+		Baud2400	= 5,
+		Baud4800	= 6,
+		Baud9600	= 7,
+		Baud19200	= 8,
+		Baud38400	= 9,
+		Baud57600	= 10,
+		Baud115200	= 11
+	};
+	enum Parity {			// parity_bits, bits 3-4
+		ParityNone	= 0,
+		ParityOdd	= 1,
+		ParityEven	= 2
+	};
+
+	uint8_t	output_baud_rate; //  Output baud rate (Baud) 
+	uint8_t	input_baud_rate; //  Input baud rate (Baud) 
+	uint8_t	parity_bits;	//  Bits 0-1: data bits - 5, bits 3-4: Parity 
+	uint8_t	stop_flow;	//  Bit 0: 2 stop bits, bit 1: hardware flow control 
+	uint8_t	out_protocol;	//  Output protocol (2=TSIP) 
+	uint8_t	in_protocol;	//  Input protocol (2=TSIP) 
+
+	static uint8_t baud_code(unsigned baud);	// 0 if unsupported
+	static unsigned baud_rate(uint8_t code);	// 0 if unknown
+};
 
 //////////////////////////////////////////////////////////////////////
 // Response 40 : Almanac Data for Single Satellite 
@@ -424,6 +457,88 @@ struct s_R58 {
 			double	odot_n;
 		} s6;
 	} u;
+
+	typedef decltype(u)::s_almanac		s_almanac;
+	typedef decltype(u)::s_health		s_health;
+	typedef decltype(u)::s_ionosphere	s_ionosphere;
+	typedef decltype(u)::s_utc		s_utc;
+	typedef decltype(u)::s_ephemeris	s_ephemeris;
+};
+
+//////////////////////////////////////////////////////////////////////
+// Response 58, every record: get(s_R58set&,arena,size) decodes the
+// n bytes of records into an array of the datatype's struct, in the
+// caller's storage (r58_arena_size() bytes, or arena_max for any 58).
+// Nothing is allocated:
+//
+//	uint8_t arena[s_R58set::arena_max];
+//	s_R58set set;
+//
+//	if ( rxpkt.get(set,arena,sizeof arena) && set.datatype == s_R58::Almanac )
+//		for ( unsigned x=0; x<set.count; ++x )
+//			use(set.rec.almanac[x]);
+//////////////////////////////////////////////////////////////////////
+
+// 58 bytes per record on the wire, and as a struct in the arena
+constexpr unsigned
+r58_wire_size(unsigned datatype) {
+	switch ( datatype ) {
+	case s_R58::Almanac :	 return 66;
+	case s_R58::Health :	 return 37;
+	case s_R58::Ionosphere : return 40;
+	case s_R58::UTC :	 return 39;
+	case s_R58::Ephemeris :	 return 167;
+	}
+	return 0;
+}
+
+constexpr size_t
+r58_rec_size(unsigned datatype) {
+	switch ( datatype ) {
+	case s_R58::Almanac :	 return sizeof(s_R58::s_almanac);
+	case s_R58::Health :	 return sizeof(s_R58::s_health);
+	case s_R58::Ionosphere : return sizeof(s_R58::s_ionosphere);
+	case s_R58::UTC :	 return sizeof(s_R58::s_utc);
+	case s_R58::Ephemeris :	 return sizeof(s_R58::s_ephemeris);
+	}
+	return 0;
+}
+
+// Arena for n bytes of records (the slack aligns the first)
+constexpr size_t
+r58_arena_size(unsigned datatype,unsigned n) {
+	return r58_wire_size(datatype)
+		? n / r58_wire_size(datatype) * r58_rec_size(datatype) + alignof(double) - 1
+		: 0;
+}
+
+// Arena for any 58 (n is a byte)
+constexpr size_t
+r58_arena_max() {
+	size_t m = 0;
+
+	for ( unsigned t=s_R58::Almanac; t<=s_R58::Ephemeris; ++t )
+		if ( r58_arena_size(t,255) > m )
+			m = r58_arena_size(t,255);
+	return m;
+}
+
+struct s_R58set {
+	uint8_t		operation;	//  Type of satellite operation (flags)
+	s_R58::Type	datatype;	//  Type of records held
+	uint8_t		sv_prn;		//  All satellites (0) or specific
+	uint8_t		n;		//  Bytes of record data
+	unsigned	count;		//  Records decoded into the arena
+	union	{
+		void			*any;
+		s_R58::s_almanac	*almanac;
+		s_R58::s_health		*health;
+		s_R58::s_ionosphere	*ionosphere;
+		s_R58::s_utc		*utc;
+		s_R58::s_ephemeris	*ephemeris;
+	} rec;
+
+	static constexpr size_t arena_max = r58_arena_max();
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -636,6 +751,19 @@ struct s_R8FA5 {
 	int16_t	mbz;
 };
 
+//////////////////////////////////////////////////////////////////////
+// Every other report in msgs.dat (generated by rgen)
+//////////////////////////////////////////////////////////////////////
+
+#include "rstruct.h"
+
+//////////////////////////////////////////////////////////////////////
+// Id classifier: non-zero for ids whose reports carry a sub id byte
+// (super packets), making the full id (id << 8) | sub id
+//////////////////////////////////////////////////////////////////////
+
+extern const uint8_t tsip_super[256];
+
 //////////////////////////////////////////////////////////////////////
 // Parse a Received Packet
 //////////////////////////////////////////////////////////////////////
@@ -646,6 +774,34 @@ class RxPacket {
 	uint16_t	offset;		// Extraction offset
 	bool		state_sd;	// Single/Double precision
 
+	template <class R> friend class RxRecord;
+
+protected:
+	// Bytes at offset for a decoder (0 if too short), offset moved past
+	inline const uint8_t *fixed(unsigned size) {
+		const uint8_t *p = buf + offset;
+
+		if ( offset > length || unsigned(length - offset) < size )
+			return 0;
+		offset += size;
+		return p;
+	}
+	inline const uint8_t *fixed(unsigned size,unsigned size_sd) {
+		return fixed(state_sd ? size_sd : size);
+	}
+	// At least min bytes, at most size (size_sd): n is the count taken
+	inline const uint8_t *partial(unsigned min,unsigned size,unsigned size_sd,unsigned& n) {
+		const uint8_t *p = buf + offset;
+
+		n = offset < length ? length - offset : 0;
+		if ( n < min )
+			return 0;
+		if ( n > (state_sd ? size_sd : size) )
+			n = state_sd ? size_sd : size;
+		offset += n;
+		return p;
+	}
+
 public:	RxPacket();
 	void load(uint8_t *buf,uint16_t buflen);
 	inline uint16_t size() { return length; }
@@ -668,6 +824,7 @@ public:	RxPacket();
 
 	bool get(s_R1C81& recd);
 	bool get(s_R1C83& recd);
+	bool get(s_R3D& recd);
 	bool get(s_R40& recd);
 	bool get(s_R41& recd);
 	bool get(s_R42& recd);
@@ -688,6 +845,7 @@ public:	RxPacket();
 	bool get(s_R56& recd);
 	bool get(s_R57& recd);
 	bool get(s_R58& recd);
+	bool get(s_R58set& recd,void *arena,size_t size);
 	bool get(s_R59& recd);
 	bool get(s_R5A& recd);
 	bool get(s_R5B& recd);
@@ -703,6 +861,8 @@ public:	RxPacket();
 	bool get(s_R8FAB& recd);
 	bool get(s_RBB00& recd);
 
+#include "rget.h"				// Generated decoders
+
 	inline void set_precision(bool dprecision) { state_sd = dprecision; }
 	inline bool is_double() { return state_sd; }
 };
@@ -779,6 +939,8 @@ public:	TxPacket();
 	bool C3A(uint8_t prn=0);	// Last Raw Measurement Request for sat prn
 	bool C3B(uint8_t prn=0);	// Satellite Ephemeris Status Request
 	bool C3C(uint8_t prn=0);	// Satellite Tracking Status Request
+	bool C3D();			// Serial Port Configuration Request
+	bool C3D(s_R3D& parms);		// Set Serial Port Configuration
 	bool C3F11();			// EEPROM Segment Commands
 
 	bool C8EA5(s_R8FA5& parms);	// Set Packet Broadcast Mask
@@ -786,6 +948,7 @@ public:	TxPacket();
 	bool CBB00(s_RBB00& parms);
 
 	inline uint16_t size() { return buflen; }
+	inline const uint8_t *data() { return buf; }
 };
 
 #endif // TSIP_HPP
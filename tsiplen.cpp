@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////
+// tsiplen.cpp -- TSIP Report Length Rules (from msgs.dat)
+// Date: Sun Oct 18 18:14:02 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+
+#include "tsiplen.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Report lengths, sorted by id and sub id, generated by rgen from
+// the field offsets in msgs.dat; single:double fields give a range,
+// and reports ending in a 1-n field have no maximum. Reports whose
+// length depends on a count (47, 6D) or on the firmware (45) have
+// the shortest useful length as minimum.
+//////////////////////////////////////////////////////////////////////
+
+static const s_tsiplen rules[] = {
+#include "rlength.h"
+};
+
+static const int nrules = sizeof rules / sizeof rules[0];
+
+//////////////////////////////////////////////////////////////////////
+// Index of the first rule for id (nrules if none)
+//////////////////////////////////////////////////////////////////////
+
+static int
+first(uint8_t id) {
+	int lo = 0, hi = nrules - 1, mid;
+
+	while ( lo <= hi ) {
+		mid = (lo + hi) / 2;
+		if ( rules[mid].id < id )
+			lo = mid + 1;
+		else	hi = mid - 1;
+	}
+	return lo < nrules && rules[lo].id == id ? lo : nrules;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Find the rule for id (and subid, for ids that have them)
+//
+// RETURNS:
+//	Rule, or 0 if none
+//////////////////////////////////////////////////////////////////////
+
+const s_tsiplen *
+tsip_length(uint8_t id,int subid) {
+
+	for ( int x=first(id); x < nrules && rules[x].id == id; ++x )
+		if ( rules[x].subid < 0 || rules[x].subid == subid )
+			return &rules[x];
+	return 0;
+}
+
+int
+tsip_length_rule(const uint8_t *packet,int length,int& minlen,int& maxlen) {
+	const s_tsiplen *rule;
+	int x;
+
+	if ( length < 1 || (x = first(packet[0])) >= nrules )
+		return 0;
+	if ( rules[x].subid >= 0 && length < 2 )
+		return -1;			// Need the sub id
+
+	rule = tsip_length(packet[0],length < 2 ? -1 : packet[1]);
+	if ( !rule )
+		return 0;
+	minlen = rule->minlen;
+	maxlen = rule->maxlen;
+	return 1;
+}
+
+// End tsiplen.cpp
@@ -0,0 +1,38 @@
+//////////////////////////////////////////////////////////////////////
+// tsiplen.hpp -- TSIP Report Length Rules (from msgs.dat)
+// Date: Sun Oct 18 18:12:37 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef TSIPLEN_HPP
+#define TSIPLEN_HPP
+
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////////
+// Length rule for one report. Lengths are of the unstuffed packet,
+// id (and sub id) included.
+//////////////////////////////////////////////////////////////////////
+
+struct s_tsiplen {
+	uint8_t		id;		// Report id
+	int16_t		subid;		// Sub id, or -1 if none
+	uint16_t	minlen;		// Shortest valid packet
+	uint16_t	maxlen;		// Longest valid packet (0 : no limit)
+};
+
+const s_tsiplen *tsip_length(uint8_t id,int subid=-1);
+
+//////////////////////////////////////////////////////////////////////
+// Length rule lookup for TsipFramer (see lenrule_t)
+//
+// RETURNS:
+//	1	- Rule found: minlen, maxlen set (maxlen 0 : no limit)
+//	0	- No rule for this id (accept any length)
+//	-1	- Id has sub ids: need length >= 2
+//////////////////////////////////////////////////////////////////////
+
+int tsip_length_rule(const uint8_t *packet,int length,int& minlen,int& maxlen);
+
+#endif // TSIPLEN_HPP
+
+// End tsiplen.hpp
@@ -10,156 +10,406 @@
 #include <unistd.h>
 #include <errno.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <limits.h>
 #include <poll.h>
+#include <time.h>
 #include <assert.h>
 
 #include "ttyio.hpp"
+#include "tsip.hpp"
+#include "tsiplen.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Open device dev (a serial port, or anything Transport::create()
+// accepts), or use fd if fd >= 0
+//////////////////////////////////////////////////////////////////////
 
 void
-Packet::open(const char *dev,int maxbuflen,int fd) {
-	struct termios tios;
-	int rc;
+Packet::open(const char *dev,int maxbuflen,int fd,const SerialConfig *cfg) {
+	Transport *t;
 
 	if ( !dev )
 		dev = "/dev/cu.usbserial-A100MX3L";
 
+	if ( fd < 0 ) {
+		t = Transport::create(dev,cfg);
+		assert(t);
+	} else if ( isatty(fd) ) {
+		TtyTransport *tty = new TtyTransport;
+		SerialConfig sc;
+		bool ok;
+
+		if ( cfg )
+			sc = *cfg;
+		ok = tty->attach(fd,sc);
+		assert(ok);
+		t = tty;
+	} else	{
+		t = new Transport;
+		t->attach(fd);
+	}
+	open(t,maxbuflen);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Read packets from an open transport, which Packet now owns. The
+// ring buffer is sized for the transport's preferred read size.
+//////////////////////////////////////////////////////////////////////
+
+void
+Packet::open(Transport *t,int maxbuflen) {
+
+	assert(t && t->fd() >= 0);
+
 	if ( maxbuflen <= 0 )
 		maxbuflen = 1024;
 
+	transport = t;
+	tty_fd = t->fd();
+
+	rbufsize = t->read_size();
+	assert(rbufsize && !(rbufsize & (rbufsize - 1)));
+
 	buf = new uint8_t[maxbuflen+1];
+	rbuf = new uint8_t[rbufsize];
+	rhead = rtail = 0;
+	memset(&iostats,0,sizeof iostats);
 
 	maxlen = maxbuflen;
-	buflen = 0;
-	state = pkt_idle;
-	ungot = false;
-	unbyte = 0;
-	tty_fd = -1;
+	framer.open(buf,maxbuflen);
+	framer.setrule(tsip_length_rule);
 
-	if ( fd < 0 ) {
-		device = strdup(dev);
-		tty_fd = ::open(device,O_RDWR);
-		assert(tty_fd >= 0);
-	} else	{
-		device = 0;
-		tty_fd = fd;
+	if ( t->config() )
+		serial = *t->config();		// Settings applied at open
+}
+
+//////////////////////////////////////////////////////////////////////
+// Check packet lengths against the msgs.dat length rules (default
+// on). Off, any packet that fits the buffer is accepted.
+//////////////////////////////////////////////////////////////////////
+
+void
+Packet::set_length_rules(bool on) {
+	framer.setrule(on ? tsip_length_rule : 0);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Apply new port settings (serial ports only). Output still queued
+// is sent at the old settings first.
+//
+// RETURNS:
+//	true	- Settings applied and kept (config())
+//	false	- Not a serial port, or rejected by the driver
+//////////////////////////////////////////////////////////////////////
+
+bool
+Packet::configure(const SerialConfig& cfg) {
+	SerialConfig newcfg = cfg;
+
+	if ( !transport->configure(newcfg) )
+		return false;
+	serial = newcfg;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Discard input not yet framed: queued in the driver, in the ring
+// and any partial packet
+//////////////////////////////////////////////////////////////////////
+
+void
+Packet::discard() {
+
+	tcflush(tty_fd,TCIFLUSH);
+	rhead = rtail = 0;
+	framer.reset();
+}
+
+struct s_await {
+	uint8_t	baud_code;	// Wanted output baud code (0 : any)
+	bool	seen;		// Matching 3D report received
+};
+
+static void
+await_cb(void *arg,uint8_t *packet,int length,bool ended) {
+	s_await& aw = *(s_await *)arg;
+	RxPacket rx;
+	s_R3D r;
+
+	rx.load(packet,length);
+	if ( !ended || rx.id() != 0x3D || !rx.get(r) )
+		return;
+	if ( !aw.baud_code || r.output_baud_rate == aw.baud_code )
+		aw.seen = true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Wait up to ms for a 3D report with output baud baud_code (0 : any
+// 3D report). With query, a 3D request is sent every 250 ms, so a
+// lost request or reply is retried. Other packets are discarded.
+//////////////////////////////////////////////////////////////////////
+
+bool
+Packet::await_r3d(uint8_t baud_code,int ms,bool query) {
+	uint64_t deadline = now_ns() + uint64_t(ms) * 1000000, next = 0, t;
+	struct pollfd pfd;
+	s_await aw;
+	TxPacket tx;
+	uint8_t txbuf[8];
+	int rc;
+
+	aw.baud_code = baud_code;
+	aw.seen = false;
+
+	while ( !aw.seen && (t = now_ns()) < deadline ) {
+		if ( query && t >= next ) {
+			tx.open(txbuf,sizeof txbuf);
+			tx.C3D();
+			put(tx);
+			next = t + 250000000ull;
+		}
+
+		pfd.fd = tty_fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		ms = int((deadline - t) / 1000000) + 1;
+		if ( query && ms > 250 )
+			ms = 250;
+		do	{
+			rc = poll(&pfd,1,ms);
+			++iostats.polls;
+		} while ( rc < 0 && errno == EINTR );
+
+		if ( rc > 0 && pump(await_cb,&aw) < 0 )
+			return false;		// EOF
 	}
+	return aw.seen;
+}
 
-	if ( isatty(tty_fd) ) {
-		rc = tcgetattr(tty_fd,&tios);
-		assert(!rc);
-		cfsetspeed(&tios,9600);
-		cfmakeraw(&tios);
-
-		tios.c_cflag |= PARODD | PARENB;
-		tios.c_cflag &= ~CSIZE;
-		tios.c_cflag |= CS8;
-		rc = tcsetattr(tty_fd,TCSANOW,&tios);
-		assert(!rc);
+//////////////////////////////////////////////////////////////////////
+// Move the receiver and the port to baud (38400, 57600, 115200..)
+//
+// The receiver is sent a 3D command for baud, keeping the current
+// parity and stop bits, and its 3D reply is awaited at the old
+// speed. The port is then switched and the link verified by 3D
+// requests for up to ms. If that fails, the receiver is told to go
+// back (at the new speed, in case it did switch) and the port is
+// returned to the old speed. Packets arriving meanwhile are
+// discarded.
+//
+// RETURNS:
+//	true	- Both ends now at baud, link verified
+//	false	- Not a serial port, baud unsupported, or the switch
+//		  failed (both ends returned to the old speed)
+//////////////////////////////////////////////////////////////////////
+
+bool
+Packet::set_baud(unsigned baud,int ms) {
+	SerialConfig oldcfg = serial, newcfg = serial;
+	uint8_t oldcode = s_R3D::baud_code(serial.baud);
+	uint8_t newcode = s_R3D::baud_code(baud);
+	s_R3D parms;
+	TxPacket tx;
+	uint8_t txbuf[32];
+
+	if ( !transport->config() || !newcode || !oldcode
+	  || !SerialConfig::valid_baud(baud) )
+		return false;
+	if ( baud == serial.baud )
+		return await_r3d(newcode,ms,true);
+
+	parms.output_baud_rate = parms.input_baud_rate = newcode;
+	parms.parity_bits = uint8_t(serial.databits - 5);
+	if ( serial.parity == 'O' )
+		parms.parity_bits |= s_R3D::ParityOdd << 3;
+	else if ( serial.parity == 'E' )
+		parms.parity_bits |= s_R3D::ParityEven << 3;
+	parms.stop_flow = serial.stopbits == 2 ? 1 : 0;
+	parms.out_protocol = parms.in_protocol = 2;	// TSIP
+
+	tx.open(txbuf,sizeof txbuf);
+	tx.C3D(parms);
+	put(tx);
+	await_r3d(newcode,ms < 500 ? ms : 500,false);	// Reply at old speed
+
+	newcfg.baud = baud;
+	if ( configure(newcfg) ) {
+		discard();
+		if ( await_r3d(newcode,ms,true) )
+			return true;
+
+		// Fall back: the receiver may have switched without us seeing it
+		parms.output_baud_rate = parms.input_baud_rate = oldcode;
+		tx.open(txbuf,sizeof txbuf);
+		tx.C3D(parms);
+		put(tx);
+		configure(oldcfg);
 	}
+	discard();
+	await_r3d(oldcode,ms,true);
+	return false;
 }
 
 Packet::Packet() {
-	device = 0;
+	transport = 0;
 	tty_fd = -1;
 	buf = 0;
-	buflen = 0;
 	maxlen = 0;
-	state = pkt_idle;
-	ungot = false;
-	unbyte = 0x00;
+	pool = 0;
+	slab = 0;
+	rbuf = 0;
+	rbufsize = 0;
+	rhead = rtail = 0;
+	gap_ms = 250;
+	rtime_ns = rtime_rt_ns = 0;
+	memset(&fstamp,0,sizeof fstamp);
+	memset(&pstamp,0,sizeof pstamp);
+	memset(&iostats,0,sizeof iostats);
+	txwrites = 0;
+	cancel_fd = -1;
 }
 
 Packet::~Packet() {
-	close(tty_fd);
+	delete transport;
+	transport = 0;
 	tty_fd = -1;
-	if ( buf )
-		delete buf;
+	delete[] buf;
 	buf = 0;
+	if ( slab )
+		pool->free(slab);
+	slab = 0;
+	delete[] rbuf;
+	rbuf = 0;
 }
 
 //////////////////////////////////////////////////////////////////////
-// Read a byte from fd
+// Read everything available from tty_fd into the ring buffer
+//
+// RETURNS:
+//	> 0	- Number of bytes added to the ring
+//	0	- EOF or read error
 //////////////////////////////////////////////////////////////////////
 
 int
-Packet::getb(int fd) {
-	uint8_t byte;
+Packet::fill() {
+	unsigned wx, room;
 	int rc;
 
+	if ( rhead == rtail )
+		rhead = rtail = 0;		// Empty: reuse from the start
+
+	wx = rhead & (rbufsize - 1);
+	room = rbufsize - (rhead - rtail);
+	if ( room > rbufsize - wx )
+		room = rbufsize - wx;		// Contiguous part only
+	assert(room > 0);
+
 	do	{
-		rc = read(fd,&byte,1);
-		if ( !rc )
-			return -1;		// EOF
+		rc = read(tty_fd,rbuf+wx,room);
+		++iostats.reads;
 	} while ( rc < 0 && errno == EINTR );
-	assert(rc==1);
-	return (int)byte;
+	timestamp();				// Arrival time of these bytes
+	if ( rc < 0 )
+		return 0;			// I/O error (e.g. unplugged): EOF
+
+	rhead += rc;
+	iostats.bytes += rc;
+	return rc;
+}
+
+uint64_t
+Packet::now_ns() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return uint64_t(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
 }
 
 //////////////////////////////////////////////////////////////////////
-// Get a byte from serial port or stdin
-// 
+// Note the arrival time of the bytes just read, on both clocks
+//////////////////////////////////////////////////////////////////////
+
+void
+Packet::timestamp() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	rtime_ns = uint64_t(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+	clock_gettime(CLOCK_REALTIME,&ts);
+	rtime_rt_ns = uint64_t(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Feed bytes from the last read to the framer, stamping the packet
+// they belong to. The ring is only filled once it has been framed
+// empty, so every byte fed was read at rtime_ns/rtime_rt_ns.
+//
+// feed() stops after a completed packet, so the packet framed last
+// (ready, or still in progress) is the one started last: if the
+// framer saw a start in these bytes (after a truncation, resync,
+// reject or overflow too), that is the start of this packet.
+//
 // RETURNS:
-// 	byte_serial	- Serial byte returned
-// 	byte_stdin	- Stdin byte returned
-//	byte_timeout	- No byte (timed out)
-//	byte_eof	- EOF when not a tty and at EOF
-// 
+//	Number of bytes consumed (see TsipFramer::feed())
 //////////////////////////////////////////////////////////////////////
 
-Packet::e_gstate
-Packet::getb(uint8_t& byte,int ms) {
+size_t
+Packet::feed(const uint8_t *data,size_t len) {
+	unsigned long starts = framer.starts();
+	size_t used = framer.feed(data,len);
 
-	if ( ungot ) {
-		byte = unbyte;
-		ungot = false;
-		return byte_serial;
+	if ( framer.idle() && !framer.ready() )
+		return used;			// No packet bytes seen
+
+	if ( framer.starts() != starts ) {
+		fstamp.mono_start = rtime_ns;	// Leading DLE in this read
+		fstamp.real_start = rtime_rt_ns;
 	}
+	fstamp.mono_end = rtime_ns;		// Latest byte of this packet
+	fstamp.real_end = rtime_rt_ns;
+	return used;
+}
 
-	int x, n = 2;
-	struct pollfd fds[n];
-	int rc;
+//////////////////////////////////////////////////////////////////////
+// Wait for data from the serial port (commands are read elsewhere,
+// see cmdchan.hpp, so only the receiver's fd is polled, and the
+// cancel fd if one is set)
+// 
+// RETURNS:
+// 	byte_serial	- Serial data added to the ring buffer
+//	byte_timeout	- No data (timed out)
+//	byte_eof	- EOF when not a tty and at EOF, or cancelled
+// 
+//////////////////////////////////////////////////////////////////////
 
-	fds[0].fd = tty_fd;
-	fds[0].events = POLLIN;
-	fds[0].revents = 0;
+Packet::e_gstate
+Packet::wait(int ms) {
+	struct pollfd pfd[2];
+	int nfds = cancel_fd >= 0 ? 2 : 1;
+	int rc;
 
-	fds[1].fd = 0;
-	fds[1].events = POLLIN;
-	fds[1].revents = 0;
+	if ( !transport->pollable() )
+		return fill() ? byte_serial : byte_eof;	// Always readable
 
-	if ( fds[0].fd == fds[1].fd )
-		n = 1;		// stdin is packet data in (not a tty)
+	pfd[0].fd = tty_fd;
+	pfd[0].events = POLLIN;
+	pfd[1].fd = cancel_fd;
+	pfd[1].events = POLLIN;
 
 	do	{
-		rc = poll(fds,n,ms);
+		pfd[0].revents = pfd[1].revents = 0;
+		rc = poll(pfd,nfds,ms);
+		++iostats.polls;
 	} while ( rc < 0 && errno == EINTR );
 
-	for ( x=0; x<n; ++x ) {
-		if ( fds[x].revents & POLLIN ) {
-			int b = getb(fds[x].fd);
-			if ( b == -1 )
-				return byte_eof;
-			byte = (uint8_t) b & 0xFF;
-			if ( !x )
-				return byte_serial;
-			else	return byte_stdin;
-		}
-	}
-
+	if ( pfd[1].revents )
+		return byte_eof;		// Cancelled
+	if ( pfd[0].revents & (POLLIN|POLLHUP|POLLERR) )
+		return fill() ? byte_serial : byte_eof;
 	return byte_timeout;
 }
 
-//////////////////////////////////////////////////////////////////////
-// Put back a read-ahead byte
-//////////////////////////////////////////////////////////////////////
-
-void
-Packet::unget(uint8_t byte) {
-	assert(!ungot);
-	ungot = true;
-	unbyte = byte;
-}
-
 //////////////////////////////////////////////////////////////////////
 // Write one byte out to serial port
 //////////////////////////////////////////////////////////////////////
@@ -170,117 +420,342 @@ Packet::putb(uint8_t byte) {
 
 	do	{
 		rc = write(tty_fd,&byte,1);
+		txwrites.fetch_add(1,std::memory_order_relaxed);
 	} while ( rc < 0 && errno == EINTR );
 	assert(rc == 1);
 }
 
 //////////////////////////////////////////////////////////////////////
-// Put n bytes
+// Put n bytes (one write() unless the driver takes a partial write)
 //////////////////////////////////////////////////////////////////////
 
 void
 Packet::put(uint8_t *buf,uint16_t len) {
+	int rc;
 
-	for ( ; len > 0; --len )
-		putb(*buf++);
+	while ( len > 0 ) {
+		do	{
+			rc = write(tty_fd,buf,len);
+			txwrites.fetch_add(1,std::memory_order_relaxed);
+		} while ( rc < 0 && errno == EINTR );
+		assert(rc > 0);
+		buf += rc;
+		len -= rc;
+	}
 }
 
 //////////////////////////////////////////////////////////////////////
-// Put a byte into the receiving buffer
+// Put one encoded TxPacket frame
 //////////////////////////////////////////////////////////////////////
 
 void
-Packet::putbuf(uint8_t byte) {
+Packet::put(TxPacket& frame) {
+	put((uint8_t *)frame.data(),frame.size());
+}
 
-	assert(buflen > 0 || byte != 0x10);
+//////////////////////////////////////////////////////////////////////
+// Put count encoded frames with one writev() (more only after a
+// partial write, or beyond IOV_MAX frames). Frames go out in order
+// and back to back, so a configuration sequence is sent as one burst.
+//////////////////////////////////////////////////////////////////////
 
-	if ( buflen >= maxlen ) {	// discard packet -- too long
-		state = pkt_idle;
-		buflen = 0;
-	} else	{
-		buf[buflen++] = byte;
+void
+Packet::put(TxPacket *frames[],int count) {
+	int x, ix = 0, n = 0, rc;
+
+	if ( count <= 0 )
+		return;
+
+	struct iovec iov[count];
+
+	for ( x=0; x<count; ++x ) {
+		if ( !frames[x]->size() )
+			continue;
+		iov[n].iov_base = (void *)frames[x]->data();
+		iov[n].iov_len = frames[x]->size();
+		++n;
+	}
+
+	while ( ix < n ) {
+		do	{
+			rc = writev(tty_fd,iov+ix,n-ix < IOV_MAX ? n-ix : IOV_MAX);
+			txwrites.fetch_add(1,std::memory_order_relaxed);
+		} while ( rc < 0 && errno == EINTR );
+		assert(rc > 0);
+
+		// Skip what was written, resuming mid-frame if partial
+		while ( ix < n && size_t(rc) >= iov[ix].iov_len )
+			rc -= iov[ix++].iov_len;
+		if ( ix < n ) {
+			iov[ix].iov_base = (uint8_t *)iov[ix].iov_base + rc;
+			iov[ix].iov_len -= rc;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Push ring buffer contents through the framer until it has a packet
+//
+// RETURNS:
+//	true	- framer has a packet ready
+//	false	- ring buffer is empty
+//////////////////////////////////////////////////////////////////////
+
+bool
+Packet::frame() {
+	unsigned rx, avail;
+
+	while ( rhead != rtail && !framer.ready() ) {
+		rx = rtail & (rbufsize - 1);
+		avail = rhead - rtail;
+		if ( avail > rbufsize - rx )
+			avail = rbufsize - rx;	// Contiguous part only
+		rtail += feed(rbuf+rx,avail);
+	}
+	return framer.ready();
+}
+
+//////////////////////////////////////////////////////////////////////
+// Count a delivered packet and its ETX latency, and keep its stamps
+//////////////////////////////////////////////////////////////////////
+
+void
+Packet::account(bool ended) {
+
+	++iostats.packets;
+	pstamp = fstamp;
+
+	if ( ended ) {
+		uint64_t lat = now_ns() - pstamp.mono_end;
+
+		++iostats.lat_n;
+		iostats.lat_last_ns = lat;
+		iostats.lat_sum_ns += lat;
+		if ( lat > iostats.lat_max_ns )
+			iostats.lat_max_ns = lat;
 	}
 }
 
 //////////////////////////////////////////////////////////////////////
 // Return a packet
+//
+// Ring buffer contents are pushed through the framer until it has a
+// packet, which is returned as soon as its DLE ETX is seen. Between
+// packets poll() has no timeout, so an idle port causes no wakeups;
+// inside a packet a gap of gap_ms ends it (ended=false).
 //////////////////////////////////////////////////////////////////////
 
 void
 Packet::get(uint8_t **packet,int *length,bool& ended) {
-	uint8_t byte;
-	e_gstate e;
+	int ms;
 
-	buflen = 0;
 	ended = false;
 
-	//////////////////////////////////////////////////////////////
-	// First wait for arrival of 0x10 (DLE)
-	//////////////////////////////////////////////////////////////
-
-	do	{
-		e = getb(byte,250);
+	while ( !frame() ) {
+		ms = framer.idle() || gap_ms <= 0 ? -1 : gap_ms;
 
-		switch ( e ) {
+		switch ( wait(ms) ) {
 		case byte_eof :
 			*length = 0;
 			ended = false;
 			return;
 		case byte_serial :
-			switch ( state ) {
-			case pkt_idle :
-				if ( byte == 0x10 ) {
-					state = pkt_data;
-					buflen = 0;
-				}
-				break;
-			case pkt_data :
-				if ( byte == 0x10 ) {
-					if ( buflen > 0 )
-						state = pkt_escape;
-				} else	{
-					putbuf(byte);
-				}
-				break;	
-			case pkt_escape :
-				if ( byte == 0x10 ) {
-					putbuf(byte);
-					state = pkt_data;
-				} else if ( byte == 0x03 ) {
-					state = pkt_end;
-					ended = true;
-				} else	{
-					unget(byte);
-					state = pkt_idle;
-				}
-				break;
-			case pkt_end :
-				assert(0);
-			}
-			break;
-		case byte_stdin :
-			if ( callback )
-				callback(*this,(char)byte);
 			break;
 		case byte_timeout :
-			switch ( state ) {
-			case pkt_idle :
-				break;
-			case pkt_data :
-			case pkt_escape :
-				state = pkt_end;
-				break;
-			case pkt_end :
-				assert(0);
-			}
+			framer.flush();
 			break;
 		}
-	} while ( state != pkt_end );
+	}
+
+	*packet = framer.packet();
+	*length = framer.length();
+	ended = framer.ended();
+	framer.release();			// Caller owns buf until next get()
+	account(ended);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Non-blocking service for an event loop (see Reactor)
+//
+// Call when tty_fd is readable: performs one read() and passes every
+// packet completed by it to cb. The packet buffer and stamp() are
+// only valid during the callback.
+//
+// RETURNS:
+//	>= 0	- Number of packets delivered
+//	-1	- EOF
+//////////////////////////////////////////////////////////////////////
+
+int
+Packet::pump(framecb_t cb,void *arg) {
+	int n = 0;
+
+	if ( !fill() )
+		return -1;
+
+	while ( frame() ) {
+		bool ended = framer.ended();
+
+		account(ended);
+		cb(arg,framer.packet(),framer.length(),ended);
+		framer.release();
+		++n;
+	}
+	return n;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Frame bytes read by someone else (e.g. an io_uring completion)
+// directly, without copying them into the ring buffer. Every packet
+// completed is passed to cb, as for pump(). Call as soon as the read
+// completes: the bytes are stamped on entry.
+//
+// RETURNS:
+//	Number of packets delivered
+//////////////////////////////////////////////////////////////////////
+
+int
+Packet::push(const uint8_t *data,size_t len,framecb_t cb,void *arg) {
+	size_t used;
+	int n = 0;
 
-	*packet = buf;
-	*length = buflen;
-	state = pkt_idle;
+	timestamp();
+	iostats.bytes += len;
+
+	while ( len > 0 ) {
+		used = feed(data,len);
+		data += used;
+		len -= used;
+
+		if ( framer.ready() ) {
+			bool ended = framer.ended();
+
+			account(ended);
+			cb(arg,framer.packet(),framer.length(),ended);
+			framer.release();
+			++n;
+		}
+	}
+	return n;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Milliseconds until a partial packet times out (0 = expired), or
+// -1 when no packet is in progress or no gap timeout is set
+//////////////////////////////////////////////////////////////////////
+
+int
+Packet::gap_left() {
+	uint64_t elapsed;
+
+	if ( framer.idle() || gap_ms <= 0 )
+		return -1;
+
+	elapsed = (now_ns() - rtime_ns) / 1000000;
+	return elapsed >= uint64_t(gap_ms) ? 0 : gap_ms - int(elapsed);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Deliver a partial packet to cb (ended=false) if its gap expired
+//////////////////////////////////////////////////////////////////////
+
+bool
+Packet::expire(framecb_t cb,void *arg) {
+
+	if ( gap_left() != 0 )
+		return false;
+	return flush(cb,arg);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Deliver a partial packet to cb (ended=false) without waiting for
+// its gap: at EOF or an error no more bytes will end it
+//////////////////////////////////////////////////////////////////////
+
+bool
+Packet::flush(framecb_t cb,void *arg) {
+
+	if ( !framer.flush() )
+		return false;
+
+	account(false);
+	cb(arg,framer.packet(),framer.length(),false);
+	framer.release();
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Frame packets directly into buffers from pool (0 to stop). Call
+// after open() and between packets. Packets are limited to the pool's
+// buffer size: with buffers smaller than open()'s maxbuflen, a longer
+// packet framed into a pool buffer is dropped by the framer (counted
+// in framing().overflows), and one framed into buf while the pool was
+// exhausted is not copied (counted in pool_drops).
+//////////////////////////////////////////////////////////////////////
+
+void
+Packet::setpool(PacketPool *pool) {
+
+	if ( slab )
+		this->pool->free(slab);
+	slab = 0;
+
+	this->pool = pool;
+	if ( pool )
+		slab = pool->alloc();
+	if ( slab )
+		framer.open(slab,pool->size());
+	else	framer.open(buf,maxlen);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Return a packet in a pool buffer owned by the caller
+//
+// The framer writes straight into the pool buffer, which is handed
+// over without copying and replaced by a fresh one. Only when the
+// pool was exhausted is the packet framed into buf and copied (or
+// dropped, if the pool is still exhausted or the packet does not fit
+// a pool buffer).
+//
+// RETURNS:
+//	true	- packet returned
+//	false	- EOF
+//////////////////////////////////////////////////////////////////////
+
+bool
+Packet::get(PooledPacket& packet) {
+	uint8_t *pkt;
+	int length;
+	bool ended;
+
+	assert(pool);
+
+	for (;;) {
+		if ( !slab && (slab = pool->alloc()) != 0 )
+			framer.open(slab,pool->size());	// Framer is idle here
+
+		get(&pkt,&length,ended);
+		if ( length <= 0 )
+			return false;
+
+		if ( pkt == slab ) {
+			packet.assign(pool,slab,length,ended);
+			packet.set_stamp(pstamp);
+			slab = pool->alloc();
+			framer.open(slab ? slab : buf,slab ? pool->size() : maxlen);
+			return true;
+		}
+
+		uint8_t *copy = length <= pool->size() ? pool->alloc() : 0;
+
+		if ( copy ) {
+			memcpy(copy,pkt,length);
+			packet.assign(pool,copy,length,ended);
+			packet.set_stamp(pstamp);
+			return true;
+		}
+		++iostats.pool_drops;
+	}
 }	
 
 // End ttyio.cpp
-
@@ -9,55 +9,116 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
+#include <atomic>
 
-class Packet;
+#include "framer.hpp"
+#include "pktpool.hpp"
+#include "serial.hpp"
+#include "transport.hpp"
 
-typedef void (*cmdcb_t)(Packet& pkt,char ch);
+class TxPacket;
 
-class Packet {
-	const char *device;
-	enum e_state {
-		pkt_idle,
-		pkt_data,
-		pkt_escape,
-		pkt_end
-	};
+//////////////////////////////////////////////////////////////////////
+// Input statistics (syscalls per packet)
+//////////////////////////////////////////////////////////////////////
+
+struct s_iostats {
+	unsigned long	polls;		// poll(2) calls made
+	unsigned long	reads;		// read(2) calls made
+	unsigned long	bytes;		// Bytes read from the device
+	unsigned long	packets;	// Packets returned by get()
+	unsigned long	lat_n;		// Packets ended by DLE ETX
+	uint64_t	lat_last_ns;	// Read of DLE ETX to get() return..
+	uint64_t	lat_max_ns;
+	uint64_t	lat_sum_ns;	// (divide by lat_n for mean)
+	unsigned long	pool_drops;	// Copies lost: pool exhausted, or too long
+};
+
+//////////////////////////////////////////////////////////////////////
+// One thread receives (get(), pump(), push(), or an RxThread). Any
+// one other thread may send with putb()/put() meanwhile, as the
+// command channel does: sending only writes tty_fd and counts in
+// txwrites, never touching receive state.
+//////////////////////////////////////////////////////////////////////
 
-	int	tty_fd;		// Open fd
+class Packet {
+	Transport *transport;	// Where packets come from (owned)
+	int	tty_fd;		// transport->fd()
+	SerialConfig serial;	// Port settings (when a tty)
 	uint8_t	*buf;		// Packet buffer
-	int	buflen;		// Current length of buffer
-	int	maxlen;		// Max length of buffer
-	e_state	state;		// Current state of packet buffer
+	int	maxlen;		// Size of buf
+	TsipFramer framer;	// Packet framing
+
+	PacketPool *pool;	// Buffer pool for get(PooledPacket&)
+	uint8_t	*slab;		// Pool buffer framer is using (or 0)
+
+	uint8_t	*rbuf;		// Input ring buffer
+	unsigned rbufsize;	// Ring size (power of 2, transport's read size)
+	unsigned rhead;		// Ring write index (free running)
+	unsigned rtail;		// Ring read index (free running)
 
-	cmdcb_t	callback;	// Callback for stdin data
+	int	gap_ms;		// Inter-byte gap ending a partial packet
+	uint64_t rtime_ns;	// CLOCK_MONOTONIC of last fill()
+	uint64_t rtime_rt_ns;	// CLOCK_REALTIME of last fill()
+	s_pktstamp fstamp;	// Arrival times of packet being framed
+	s_pktstamp pstamp;	// Arrival times of packet last returned
+
+	s_iostats iostats;	// Syscall counters (receive side)
+	std::atomic<unsigned long> txwrites; // write(2)/writev(2) calls made
+	int	cancel_fd;	// Readable: receiving ends as at EOF
 
 protected:
 	enum e_gstate {
 		byte_serial,
-		byte_stdin,
 		byte_timeout,
 		byte_eof	// EOF when fd is not a tty, at EOF
 	};
 
-	bool	ungot;		// True if we "ungot" a byte
-	uint8_t	unbyte;		// The "ungot" byte, if any
-
-	int getb(int fd);			// Read bytte with timeout
-	e_gstate getb(uint8_t& byte,int ms);	// Get byte with timeout
-	void unget(uint8_t byte);		// Put back a got byte
-
-	void putbuf(uint8_t byte);		// Put byte into buffer (if room)
+	int fill();				// Drain tty_fd into ring buffer
+	static uint64_t now_ns();		// CLOCK_MONOTONIC in ns
+	void timestamp();			// Set rtime_ns and rtime_rt_ns
+	size_t feed(const uint8_t *data,size_t len); // Frame and stamp
+	e_gstate wait(int ms);			// Wait for serial data
+	bool frame();				// Frame ring until packet ready
+	void account(bool ended);		// Update packet statistics
+	void discard();				// Drop all input not yet framed
+	bool await_r3d(uint8_t baud_code,int ms,bool query); // Verify link
 
 public:	Packet();
 	~Packet();
 
-	void open(const char *dev=0,int maxbuflen=1024,int fd=-1);
-	inline void registercb(cmdcb_t usrcb) { callback = usrcb; }
+	void open(const char *dev=0,int maxbuflen=1024,int fd=-1,const SerialConfig *cfg=0);
+	void open(Transport *transport,int maxbuflen=1024); // Takes ownership
+	bool configure(const SerialConfig& cfg);	// Change port settings
+	bool set_baud(unsigned baud,int ms=1000);	// Switch receiver and port
+	inline const SerialConfig& config() const { return serial; }
+	inline void set_gap_timeout(int ms) { gap_ms = ms; } // <= 0 : none
+	inline void set_cancel(int fd) { cancel_fd = fd; } // -1 : none
+	inline int cancel() const { return cancel_fd; }
+	void set_length_rules(bool on);		// Reject by msgs.dat lengths
 
 	void putb(uint8_t byte);		// Put byte out to serial port
 	void put(uint8_t *bytes,uint16_t len);	// Put len bytes
+	void put(TxPacket& frame);		// Put one encoded frame
+	void put(TxPacket *frames[],int count);	// Put frames in one writev()
 
 	void get(uint8_t **packet,int *length,bool& ended);
+
+	void setpool(PacketPool *pool);		// Frame into pool buffers
+	bool get(PooledPacket& packet);		// False at EOF
+
+	int pump(framecb_t cb,void *arg);	// Read once, deliver packets
+	int push(const uint8_t *data,size_t len,framecb_t cb,void *arg);
+	int gap_left();				// ms until partial packet expires
+	bool expire(framecb_t cb,void *arg);	// Deliver expired partial packet
+	bool flush(framecb_t cb,void *arg);	// Deliver partial packet now (EOF)
+	inline int fd() const { return tty_fd; }
+	inline Transport& get_transport() { return *transport; }
+
+	inline const s_iostats& stats() const { return iostats; }
+	inline unsigned long writes() const { return txwrites.load(std::memory_order_relaxed); }
+	inline const s_framestats& framing() const { return framer.stats(); }
+	inline const s_pktstamp& stamp() const { return pstamp; }
 };
 
 #endif // TTYIO_HPP
@@ -0,0 +1,156 @@
+//////////////////////////////////////////////////////////////////////
+// uartpkt.hpp -- Heap Free TSIP Packets from a UART (AVR/Arduino)
+// Date: Sun Oct 18 20:12:09 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef UARTPKT_HPP
+#define UARTPKT_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "framer.hpp"
+#include "tsip.hpp"
+
+//////////////////////////////////////////////////////////////////////
+// Compiler barrier: keeps ring data accesses on the right side of
+// the index updates. An ISR runs on the same core as the code it
+// interrupts, so ordering the compiler's accesses is enough.
+//////////////////////////////////////////////////////////////////////
+
+#define UART_BARRIER()	__asm__ __volatile__("" ::: "memory")
+
+//////////////////////////////////////////////////////////////////////
+// Byte ring written by a receive ISR and read by the main loop.
+// Indexes are single bytes, so each side's update is atomic even on
+// an 8-bit MCU and no interrupts need be disabled. N is a power of 2
+// up to 128. A byte arriving to a full ring is dropped and counted.
+//////////////////////////////////////////////////////////////////////
+
+template <unsigned N>
+class IsrRing {
+	static_assert(N >= 2 && N <= 128 && !(N & (N - 1)),"N must be a power of 2, 2..128");
+
+	uint8_t	data[N];
+	volatile uint8_t head;		// Written by the ISR only
+	volatile uint8_t tail;		// Written by the main loop only
+	volatile uint16_t lost;		// Bytes dropped (ring full)
+
+public:	IsrRing() : head(0), tail(0), lost(0) {}
+
+	//////////////////////////////////////////////////////////////
+	// ISR side
+	//////////////////////////////////////////////////////////////
+
+	inline bool put(uint8_t byte) {
+		uint8_t h = head;
+
+		if ( uint8_t(h - tail) >= N ) {
+			lost = lost + 1;
+			return false;
+		}
+		data[h & (N - 1)] = byte;
+		UART_BARRIER();
+		head = uint8_t(h + 1);
+		return true;
+	}
+
+	//////////////////////////////////////////////////////////////
+	// Main loop side: contiguous bytes ready at *first
+	//////////////////////////////////////////////////////////////
+
+	inline unsigned peek(const uint8_t **first) {
+		uint8_t t = tail;
+		unsigned n = uint8_t(head - t);
+
+		UART_BARRIER();
+		if ( n > N - (t & (N - 1)) )
+			n = N - (t & (N - 1));
+		*first = &data[t & (N - 1)];
+		return n;
+	}
+
+	inline void release(unsigned n) {
+		UART_BARRIER();
+		tail = uint8_t(tail + n);
+	}
+
+	inline bool empty() const { return head == tail; }
+	inline uint16_t overruns() const { return lost; } // Not atomic on 8 bit
+};
+
+//////////////////////////////////////////////////////////////////////
+// Receive and send TSIP over a UART without heap use: all storage
+// (an N byte packet buffer and an RXN byte receive ring) is inside
+// the object, so RAM use is fixed at build time.
+//
+//	ISR(USART_RX_vect) { gps.isr_rx(UDR0); }
+//
+//	loop:	while ( gps.get(&packet,&length,ended) )
+//			...packet valid until the next get()
+//
+// txb sends one byte (e.g. waits for UDRE and writes UDR0). A
+// partial packet is ended by flush(), for example when millis()
+// shows the line idle for the gap timeout.
+//////////////////////////////////////////////////////////////////////
+
+typedef void (*uarttx_t)(uint8_t byte);
+
+template <int N=256,unsigned RXN=64>
+class UartPacket {
+	uint8_t	buf[N];		// Packet buffer
+	TsipFramer framer;	// Packet framing
+	IsrRing<RXN> rx;	// Bytes from the receive ISR
+	uarttx_t txb;		// Byte transmitter
+
+	// No copies: framer points into buf
+	UartPacket(const UartPacket&) = delete;
+	UartPacket& operator=(const UartPacket&) = delete;
+
+public:	UartPacket(uarttx_t tx=0) : txb(tx) { framer.open(buf,N); }
+
+	inline void isr_rx(uint8_t byte) { rx.put(byte); } // From the ISR
+	inline void set_tx(uarttx_t tx) { txb = tx; }
+	inline void setrule(lenrule_t rule) { framer.setrule(rule); }
+
+	//////////////////////////////////////////////////////////////
+	// Frame what the ISR has received so far (never waits)
+	//
+	// RETURNS:
+	//	true	- *packet, *length and ended describe a packet
+	//	false	- No complete packet yet
+	//////////////////////////////////////////////////////////////
+
+	bool get(uint8_t **packet,int *length,bool& ended) {
+		const uint8_t *data;
+		unsigned n;
+
+		while ( !framer.ready() && (n = rx.peek(&data)) > 0 )
+			rx.release(framer.feed(data,n));
+		if ( !framer.ready() )
+			return false;
+
+		*packet = framer.packet();
+		*length = framer.length();
+		ended = framer.ended();
+		framer.release();		// Caller owns buf until next get()
+		return true;
+	}
+
+	inline bool flush() { return framer.flush(); } // End partial packet
+	inline bool idle() const { return framer.idle() && rx.empty(); }
+
+	inline void putb(uint8_t byte) { if ( txb ) txb(byte); }
+	void put(const uint8_t *bytes,uint16_t len) {
+		for ( uint16_t x=0; x<len; ++x )
+			putb(bytes[x]);
+	}
+	inline void put(TxPacket& frame) { put(frame.data(),frame.size()); }
+
+	inline uint16_t overruns() const { return rx.overruns(); }
+	inline const s_framestats& framing() const { return framer.stats(); }
+};
+
+#endif // UARTPKT_HPP
+
+// End uartpkt.hpp
@@ -0,0 +1,140 @@
+//////////////////////////////////////////////////////////////////////
+// uartsim.cpp -- Host Simulation of a UART Receive Interrupt
+// Date: Sun Oct 18 20:38:20 2026
+///////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <assert.h>
+
+#include "uartsim.hpp"
+
+UartSim *UartSim::active = 0;
+
+UartSim::UartSim() {
+	fd = -1;
+	fdflags = 0;
+	isr = 0;
+	arg = 0;
+	cps = 0;
+	tick_us = 0;
+	credit = 0;
+	eof = false;
+	nbytes = 0;
+}
+
+UartSim::~UartSim() {
+	stop();
+}
+
+//////////////////////////////////////////////////////////////////////
+// Timer signal: deliver this tick's bytes one at a time
+//////////////////////////////////////////////////////////////////////
+
+void
+UartSim::tick(int sig) {
+	UartSim *sim = active;
+	uint8_t buf[256];
+	unsigned want;
+	int e = errno, rc;
+
+	if ( !sim || sim->eof ) {
+		errno = e;
+		return;
+	}
+
+	sim->credit += uint64_t(sim->cps) * sim->tick_us;
+	want = unsigned(sim->credit / 1000000);
+	if ( want > sizeof buf )
+		want = sizeof buf;
+	sim->credit -= uint64_t(want) * 1000000;
+
+	if ( want > 0 ) {
+		rc = read(sim->fd,buf,want);
+		if ( rc == 0 || (rc < 0 && errno != EAGAIN && errno != EINTR) )
+			sim->eof = true;
+		for ( int x=0; x<rc; ++x )
+			sim->isr(buf[x],sim->arg);
+		if ( rc > 0 )
+			sim->nbytes = sim->nbytes + rc;
+	}
+	errno = e;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Start playing fd into isr at baud (char_bits bits per byte on the
+// wire). fd is made non-blocking until stop(), so an empty pipe
+// never stalls the "interrupt".
+//
+// RETURNS:
+//	true	- Timer running
+//	false	- Another simulation is active, or no timer (see errno)
+//////////////////////////////////////////////////////////////////////
+
+bool
+UartSim::start(int fd,unsigned baud,unsigned char_bits,uartisr_t isr,void *arg,unsigned burst) {
+	struct sigaction sa;
+	struct itimerval itv;
+
+	assert(baud > 0 && char_bits > 0 && isr);
+	if ( active ) {
+		errno = EBUSY;
+		return false;
+	}
+
+	this->fd = fd;
+	this->isr = isr;
+	this->arg = arg;
+	cps = baud / char_bits;
+	if ( !cps )
+		cps = 1;
+	if ( !burst )
+		burst = 1;
+	tick_us = unsigned(uint64_t(burst) * 1000000 / cps);
+	if ( tick_us < 100 )
+		tick_us = 100;			// Finest practical host timer
+	else if ( tick_us > 10000 )
+		tick_us = 10000;
+	credit = 0;
+	eof = false;
+	nbytes = 0;
+
+	fdflags = fcntl(fd,F_GETFL);
+	fcntl(fd,F_SETFL,fdflags | O_NONBLOCK);
+
+	memset(&sa,0,sizeof sa);
+	sa.sa_handler = tick;
+	sigemptyset(&sa.sa_mask);
+	sa.sa_flags = SA_RESTART;
+	if ( sigaction(SIGALRM,&sa,0) )
+		return false;
+
+	active = this;
+	itv.it_interval.tv_sec = 0;
+	itv.it_interval.tv_usec = tick_us;
+	itv.it_value = itv.it_interval;
+	if ( setitimer(ITIMER_REAL,&itv,0) ) {
+		active = 0;
+		return false;
+	}
+	return true;
+}
+
+void
+UartSim::stop() {
+	struct itimerval itv;
+
+	if ( active != this )
+		return;
+	memset(&itv,0,sizeof itv);
+	setitimer(ITIMER_REAL,&itv,0);
+	signal(SIGALRM,SIG_DFL);
+	active = 0;
+	fcntl(fd,F_SETFL,fdflags);
+}
+
+// End uartsim.cpp
@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////
+// uartsim.hpp -- Host Simulation of a UART Receive Interrupt
+// Date: Sun Oct 18 20:31:47 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef UARTSIM_HPP
+#define UARTSIM_HPP
+
+#include <stdint.h>
+
+typedef void (*uartisr_t)(uint8_t byte,void *arg);
+
+//////////////////////////////////////////////////////////////////////
+// Plays bytes from an fd into a receive "ISR" at a baud rate, so a
+// UartPacket can be tested on the host. A periodic SIGALRM stands
+// in for the interrupt: like an ISR it preempts the main loop at any
+// point, and the main loop can sleep in pause() as an MCU would in
+// sleep_mode(). Each tick delivers the bytes the wire would have
+// carried since the last one (at most burst bytes per tick; the
+// tick is shortened to suit). One simulation at a time.
+//////////////////////////////////////////////////////////////////////
+
+class UartSim {
+	int	fd;		// Byte source
+	int	fdflags;	// fd's file status flags before start()
+	uartisr_t isr;		// Receive "ISR"
+	void	*arg;		// ISR argument
+	unsigned cps;		// Characters per second
+	unsigned tick_us;	// Timer period
+	uint64_t credit;	// Bytes owed, in cps * tick units
+	volatile bool eof;	// Source exhausted
+	volatile unsigned long nbytes; // Bytes delivered
+
+	static UartSim *active;	// Simulation the signal drives
+
+protected:
+	static void tick(int sig);
+
+public:	UartSim();
+	~UartSim();
+
+	bool start(int fd,unsigned baud,unsigned char_bits,uartisr_t isr,void *arg,unsigned burst=8);
+	void stop();
+
+	inline bool done() const { return eof; }
+	inline unsigned long bytes() const { return nbytes; }
+};
+
+#endif // UARTSIM_HPP
+
+// End uartsim.hpp
@@ -0,0 +1,738 @@
+//////////////////////////////////////////////////////////////////////
+// uring.cpp -- io_uring Reactor for Many Receivers
+// Date: Sun Oct 18 14:09:15 2026
+//
+// Talks to the kernel ABI (<linux/io_uring.h>) directly, so no
+// liburing is needed to build it. Without the header (or with
+// -DTSIP_NO_URING) UringReactor::open() always returns false.
+///////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <assert.h>
+
+#include "uring.hpp"
+
+#if defined(__linux__) && defined(__has_include) && !defined(TSIP_NO_URING)
+#if __has_include(<linux/io_uring.h>)
+#define TSIP_URING	1
+#endif
+#endif
+
+#ifdef TSIP_URING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#define OP_READ_MULTISHOT	49	// IORING_OP_READ_MULTISHOT (Linux 6.7)
+
+#define UD_READ		1		// user_data: (rx << 8) | op
+#define UD_WRITE	2
+
+static const unsigned nbufs = 256;	// Provided buffers (power of 2)
+static const unsigned wq_max = 64;	// Frames queued per receiver
+static const unsigned bufsize = 4096;	// Size of each read buffer
+static const unsigned short bgid = 1;	// Provided buffer group
+
+struct s_uring {
+	int		fd;
+	bool		ext_arg;	// IORING_FEAT_EXT_ARG (wait timeout)
+
+	unsigned	*sq_head;
+	unsigned	*sq_tail;
+	unsigned	*sq_mask;
+	unsigned	*sq_array;
+	unsigned	sq_entries;
+	struct io_uring_sqe *sqes;
+
+	unsigned	*cq_head;
+	unsigned	*cq_tail;
+	unsigned	*cq_mask;
+	struct io_uring_cqe *cqes;
+
+	void		*sq_map;
+	size_t		sq_map_sz;
+	void		*cq_map;
+	size_t		cq_map_sz;
+	size_t		sqes_sz;
+
+	struct io_uring_buf *br;	// Provided buffer ring (or 0)
+	uint8_t		*bufs;		// nbufs * bufsize
+	unsigned short	br_tail;
+};
+
+struct s_wqueue {
+	struct iovec	iov[wq_max];	// Unwritten parts of queued frames
+	unsigned	n;		// Entries in iov[]
+	unsigned	inflight;	// iov[0..inflight) in the writev (0 : none)
+};
+
+static int
+sys_setup(unsigned entries,struct io_uring_params *p) {
+	return syscall(__NR_io_uring_setup,entries,p);
+}
+
+static int
+sys_enter(int fd,unsigned submit,unsigned wait,unsigned flags,void *arg,size_t argsz) {
+	return syscall(__NR_io_uring_enter,fd,submit,wait,flags,arg,argsz);
+}
+
+static int
+sys_register(int fd,unsigned op,void *arg,unsigned nargs) {
+	return syscall(__NR_io_uring_register,fd,op,arg,nargs);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Hand provided buffer bid back to the kernel
+//
+// The ring is addressed as an array of io_uring_buf with the tail in
+// bufs[0].resv: in C++ the header's flexible array member sits after
+// an empty struct and would be mis-offset.
+//////////////////////////////////////////////////////////////////////
+
+static void
+recycle(s_uring *r,unsigned short bid) {
+	struct io_uring_buf *b = &r->br[r->br_tail & (nbufs - 1)];
+
+	b->addr = (uint64_t)(uintptr_t)(r->bufs + bid * bufsize);
+	b->len = bufsize;
+	b->bid = bid;
+	__atomic_store_n(&r->br[0].resv,++r->br_tail,__ATOMIC_RELEASE);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Claim the next submission queue entry (zeroed), or 0 if full.
+// Without SQPOLL the kernel only reads the SQ inside
+// io_uring_enter(), so publishing the tail here is safe.
+//////////////////////////////////////////////////////////////////////
+
+static struct io_uring_sqe *
+get_sqe(s_uring *r) {
+	unsigned head = __atomic_load_n(r->sq_head,__ATOMIC_ACQUIRE);
+	unsigned tail = *r->sq_tail;
+	unsigned ix;
+
+	if ( tail - head >= r->sq_entries )
+		return 0;
+
+	ix = tail & *r->sq_mask;
+	memset(&r->sqes[ix],0,sizeof r->sqes[ix]);
+	r->sq_array[ix] = ix;
+	__atomic_store_n(r->sq_tail,tail+1,__ATOMIC_RELEASE);
+	return &r->sqes[ix];
+}
+
+static unsigned
+sq_pending(s_uring *r) {
+	return *r->sq_tail - __atomic_load_n(r->sq_head,__ATOMIC_ACQUIRE);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Claim an entry, handing the queued ones to the kernel if the SQ is
+// full. This only submits: no completions are waited for or reaped,
+// so it is safe while submit() is walking the CQ.
+//
+// RETURNS:
+//	Zeroed entry, or 0 if the kernel took none (e.g. EBUSY with
+//	the CQ overflowing): the caller defers to the next submit()
+//////////////////////////////////////////////////////////////////////
+
+static struct io_uring_sqe *
+claim_sqe(s_uring *r,unsigned long& enters) {
+	struct io_uring_sqe *sqe = get_sqe(r);
+	int rc;
+
+	if ( sqe )
+		return sqe;
+
+	do	{
+		rc = sys_enter(r->fd,sq_pending(r),0,0,0,0);
+		++enters;
+	} while ( rc < 0 && errno == EINTR );
+	return get_sqe(r);
+}
+
+#endif // TSIP_URING
+
+UringReactor::UringReactor() {
+	ring = 0;
+	rcvrs = 0;
+	maxrcvrs = 0;
+	nrcvrs = 0;
+	nactive = 0;
+	stopping = false;
+	dispatched = 0;
+	enters = 0;
+	wr_errors = 0;
+	short_wr = 0;
+	deferred = false;
+}
+
+UringReactor::~UringReactor() {
+
+#ifdef TSIP_URING
+	if ( ring ) {
+		if ( ring->br ) {
+			struct io_uring_buf_reg reg;
+
+			memset(&reg,0,sizeof reg);
+			reg.bgid = bgid;
+			sys_register(ring->fd,IORING_UNREGISTER_PBUF_RING,&reg,1);
+			munmap(ring->br,nbufs * sizeof(struct io_uring_buf));
+		}
+		delete[] ring->bufs;
+		munmap(ring->sqes,ring->sqes_sz);
+		if ( ring->cq_map != ring->sq_map )
+			munmap(ring->cq_map,ring->cq_map_sz);
+		munmap(ring->sq_map,ring->sq_map_sz);
+		close(ring->fd);
+		delete ring;
+	}
+#endif
+	if ( rcvrs ) {
+		for ( int x=0; x<maxrcvrs; ++x ) {
+			delete[] rcvrs[x].rbuf;
+			delete rcvrs[x].wq;
+		}
+		delete[] rcvrs;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Set up the ring and the provided buffer pool
+//
+// RETURNS:
+//	true	- ready
+//	false	- io_uring not available: use Reactor
+//////////////////////////////////////////////////////////////////////
+
+bool
+UringReactor::open(int maxrcvrs,unsigned entries) {
+#ifdef TSIP_URING
+	struct io_uring_params p;
+	struct io_uring_buf_reg reg;
+	s_uring *r;
+	int fd;
+
+	assert(!ring);
+	if ( maxrcvrs <= 0 )
+		maxrcvrs = 128;
+
+	memset(&p,0,sizeof p);
+	fd = sys_setup(entries,&p);
+	if ( fd < 0 )
+		return false;			// ENOSYS, EPERM (disabled) ..
+
+	r = new s_uring;
+	memset(r,0,sizeof *r);
+	r->fd = fd;
+	r->ext_arg = (p.features & IORING_FEAT_EXT_ARG) != 0;
+
+	r->sq_map_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	r->cq_map_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if ( p.features & IORING_FEAT_SINGLE_MMAP ) {
+		if ( r->cq_map_sz > r->sq_map_sz )
+			r->sq_map_sz = r->cq_map_sz;
+		r->cq_map_sz = r->sq_map_sz;
+	}
+
+	r->sq_map = mmap(0,r->sq_map_sz,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,fd,IORING_OFF_SQ_RING);
+	assert(r->sq_map != MAP_FAILED);
+	if ( p.features & IORING_FEAT_SINGLE_MMAP )
+		r->cq_map = r->sq_map;
+	else	{
+		r->cq_map = mmap(0,r->cq_map_sz,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,fd,IORING_OFF_CQ_RING);
+		assert(r->cq_map != MAP_FAILED);
+	}
+	r->sqes_sz = p.sq_entries * sizeof(struct io_uring_sqe);
+	r->sqes = (struct io_uring_sqe *)mmap(0,r->sqes_sz,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,fd,IORING_OFF_SQES);
+	assert(r->sqes != MAP_FAILED);
+
+	r->sq_head = (unsigned *)((char *)r->sq_map + p.sq_off.head);
+	r->sq_tail = (unsigned *)((char *)r->sq_map + p.sq_off.tail);
+	r->sq_mask = (unsigned *)((char *)r->sq_map + p.sq_off.ring_mask);
+	r->sq_array = (unsigned *)((char *)r->sq_map + p.sq_off.array);
+	r->sq_entries = p.sq_entries;
+
+	r->cq_head = (unsigned *)((char *)r->cq_map + p.cq_off.head);
+	r->cq_tail = (unsigned *)((char *)r->cq_map + p.cq_off.tail);
+	r->cq_mask = (unsigned *)((char *)r->cq_map + p.cq_off.ring_mask);
+	r->cqes = (struct io_uring_cqe *)((char *)r->cq_map + p.cq_off.cqes);
+
+	//////////////////////////////////////////////////////////////
+	// Provided buffer ring for multishot reads (Linux 5.19+)
+	//////////////////////////////////////////////////////////////
+
+	r->br = (struct io_uring_buf *)mmap(0,nbufs * sizeof(struct io_uring_buf),
+		PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+	if ( r->br == MAP_FAILED )
+		r->br = 0;
+
+	if ( r->br ) {
+		memset(&reg,0,sizeof reg);
+		reg.ring_addr = (uint64_t)(uintptr_t)r->br;
+		reg.ring_entries = nbufs;
+		reg.bgid = bgid;
+		if ( sys_register(fd,IORING_REGISTER_PBUF_RING,&reg,1) < 0 ) {
+			munmap(r->br,nbufs * sizeof(struct io_uring_buf));
+			r->br = 0;
+		}
+	}
+
+	if ( r->br ) {
+		r->bufs = new uint8_t[nbufs * bufsize];
+		r->br_tail = 0;
+		for ( unsigned x=0; x<nbufs; ++x )
+			recycle(r,x);
+	}
+
+	ring = r;
+	this->maxrcvrs = maxrcvrs;
+	rcvrs = new s_receiver[maxrcvrs];
+	for ( int x=0; x<maxrcvrs; ++x ) {
+		rcvrs[x].rbuf = 0;
+		rcvrs[x].wq = 0;
+	}
+	return true;
+#else
+	(void)maxrcvrs;
+	(void)entries;
+	return false;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Register an opened Packet and the handler for its packets
+//
+// RETURNS:
+//	Receiver index, or -1 if the table is full
+//////////////////////////////////////////////////////////////////////
+
+int
+UringReactor::add(Packet& pkt,rxhandler_t handler,void *arg) {
+#ifdef TSIP_URING
+	struct stat st;
+
+	if ( !ring || nrcvrs >= maxrcvrs )
+		return -1;
+
+	s_receiver& rcvr = rcvrs[nrcvrs];
+
+	rcvr.reactor = this;
+	rcvr.pkt = &pkt;
+	rcvr.handler = handler;
+	rcvr.arg = arg;
+	rcvr.armed = false;
+	rcvr.active = true;
+	rcvr.arm_due = false;
+	rcvr.write_due = false;
+	rcvr.wq = new s_wqueue;
+	rcvr.wq->n = 0;
+	rcvr.wq->inflight = 0;
+	rcvr.writes = 0;
+
+	// Multishot reads need a pollable fd: not a capture file
+	rcvr.multishot = ring->br != 0
+		&& !(fstat(pkt.fd(),&st) == 0 && S_ISREG(st.st_mode));
+	if ( !rcvr.multishot )
+		rcvr.rbuf = new uint8_t[bufsize];
+
+	arm(nrcvrs);
+	++nactive;
+	return nrcvrs++;
+#else
+	(void)pkt;
+	(void)handler;
+	(void)arg;
+	return -1;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Queue the read for receiver rx (deferred if the SQ stays full)
+//////////////////////////////////////////////////////////////////////
+
+void
+UringReactor::arm(int rx) {
+#ifdef TSIP_URING
+	s_receiver& rcvr = rcvrs[rx];
+	struct io_uring_sqe *sqe;
+
+	if ( !(sqe = claim_sqe(ring,enters)) ) {
+		rcvr.arm_due = deferred = true;
+		return;
+	}
+	rcvr.arm_due = false;
+
+	sqe->fd = rcvr.pkt->fd();
+	sqe->user_data = (uint64_t(rx) << 8) | UD_READ;
+
+	if ( rcvr.multishot ) {
+		sqe->opcode = OP_READ_MULTISHOT;
+		sqe->flags = IOSQE_BUFFER_SELECT;
+		sqe->buf_group = bgid;
+	} else	{
+		sqe->opcode = IORING_OP_READ;
+		sqe->addr = (uint64_t)(uintptr_t)rcvr.rbuf;
+		sqe->len = bufsize;
+		sqe->off = uint64_t(-1);	// Current file position
+	}
+	rcvr.armed = true;
+#else
+	(void)rx;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Queue count frames for receiver rx, to be written in order after
+// any already queued. The frames' buffers must stay unchanged until
+// writes(rx) drops back to 0.
+//
+// RETURNS:
+//	true	- queued
+//	false	- receiver at EOF, or too many frames already queued
+//////////////////////////////////////////////////////////////////////
+
+bool
+UringReactor::put(int rx,TxPacket *frames[],int count) {
+#ifdef TSIP_URING
+	s_receiver& rcvr = rcvrs[rx];
+	s_wqueue& wq = *rcvr.wq;
+
+	if ( !rcvr.active || count < 0 || wq.n + count > wq_max )
+		return false;
+
+	for ( int x=0; x<count; ++x ) {
+		if ( !frames[x]->size() )
+			continue;
+		wq.iov[wq.n].iov_base = (void *)frames[x]->data();
+		wq.iov[wq.n].iov_len = frames[x]->size();
+		++wq.n;
+	}
+	rcvr.writes = wq.n;
+
+	if ( !wq.inflight && !rcvr.write_due && wq.n > 0 )
+		start_write(rx);
+	return true;
+#else
+	(void)rx;
+	(void)frames;
+	(void)count;
+	return false;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Queue one writev of all frames queued for rx (deferred if the SQ
+// stays full). Only one is in flight per receiver, which keeps the
+// frames in order without linked entries.
+//////////////////////////////////////////////////////////////////////
+
+void
+UringReactor::start_write(int rx) {
+#ifdef TSIP_URING
+	s_receiver& rcvr = rcvrs[rx];
+	s_wqueue& wq = *rcvr.wq;
+	struct io_uring_sqe *sqe;
+
+	if ( !(sqe = claim_sqe(ring,enters)) ) {
+		rcvr.write_due = deferred = true;
+		return;
+	}
+	rcvr.write_due = false;
+
+	sqe->opcode = IORING_OP_WRITEV;
+	sqe->fd = rcvr.pkt->fd();
+	sqe->addr = (uint64_t)(uintptr_t)wq.iov;
+	sqe->len = wq.n;
+	sqe->off = uint64_t(-1);
+	sqe->user_data = (uint64_t(rx) << 8) | UD_WRITE;
+	wq.inflight = wq.n;
+#else
+	(void)rx;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// The writev for rx completed with res: drop the frames written,
+// resume a short write where it stopped, and queue what is left
+//////////////////////////////////////////////////////////////////////
+
+void
+UringReactor::end_write(int rx,int res) {
+#ifdef TSIP_URING
+	s_receiver& rcvr = rcvrs[rx];
+	s_wqueue& wq = *rcvr.wq;
+	unsigned x = 0, n = wq.inflight;
+	size_t left;
+
+	wq.inflight = 0;
+
+	if ( res == -EINTR || res == -EAGAIN ) {
+		;				// Write them again
+	} else if ( res <= 0 ) {
+		++wr_errors;			// Drop this writev's frames
+		x = n;
+	} else	{
+		left = size_t(res);
+		while ( x < n && left >= wq.iov[x].iov_len )
+			left -= wq.iov[x++].iov_len;
+		if ( x < n ) {
+			wq.iov[x].iov_base = (uint8_t *)wq.iov[x].iov_base + left;
+			wq.iov[x].iov_len -= left;
+			++short_wr;
+		}
+	}
+
+	memmove(wq.iov,wq.iov + x,(wq.n - x) * sizeof wq.iov[0]);
+	wq.n -= x;
+	rcvr.writes = wq.n;
+
+	if ( wq.n > 0 )
+		start_write(rx);
+#else
+	(void)rx;
+	(void)res;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Queue the reads and writes that found the SQ full
+//////////////////////////////////////////////////////////////////////
+
+void
+UringReactor::retry() {
+
+	deferred = false;
+	for ( int x=0; x<nrcvrs; ++x ) {
+		if ( rcvrs[x].arm_due && rcvrs[x].active )
+			arm(x);
+		if ( rcvrs[x].write_due )
+			start_write(x);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Framer callback: load the receiver's RxPacket and dispatch
+//////////////////////////////////////////////////////////////////////
+
+void
+UringReactor::deliver(void *arg,uint8_t *packet,int length,bool ended) {
+	s_receiver& rcvr = *(s_receiver *)arg;
+
+	rcvr.rxpkt.load(packet,length);
+	rcvr.handler(*rcvr.pkt,rcvr.rxpkt,ended,rcvr.arg);
+	++rcvr.reactor->dispatched;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Retire a receiver at EOF or on an error, first delivering the
+// packet it was framing (ended=false), as a gap timeout would
+//////////////////////////////////////////////////////////////////////
+
+void
+UringReactor::retire(s_receiver& rcvr) {
+
+	rcvr.pkt->flush(deliver,&rcvr);
+	rcvr.active = false;
+	--nactive;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Handle one completion
+//////////////////////////////////////////////////////////////////////
+
+void
+UringReactor::complete(uint64_t user_data,int res,unsigned flags) {
+#ifdef TSIP_URING
+	s_receiver& rcvr = rcvrs[user_data >> 8];
+
+	if ( (user_data & 0xFF) == UD_WRITE ) {
+		end_write(user_data >> 8,res);
+		return;
+	}
+
+	if ( res > 0 ) {
+		if ( flags & IORING_CQE_F_BUFFER ) {
+			unsigned short bid = flags >> IORING_CQE_BUFFER_SHIFT;
+
+			rcvr.pkt->push(ring->bufs + bid * bufsize,res,deliver,&rcvr);
+			recycle(ring,bid);
+		} else	{
+			rcvr.pkt->push(rcvr.rbuf,res,deliver,&rcvr);
+		}
+	}
+
+	if ( rcvr.multishot && (flags & IORING_CQE_F_MORE) )
+		return;				// Read still armed
+	rcvr.armed = false;
+
+	if ( res == 0 || !rcvr.active ) {	// EOF
+		if ( rcvr.active )
+			retire(rcvr);
+		return;
+	}
+
+	if ( res < 0 ) {
+		switch ( -res ) {
+		case EINVAL :			// No multishot read (< 6.7)
+		case EBADFD :			// fd not pollable
+		case EOPNOTSUPP :
+			if ( !rcvr.multishot ) {
+				retire(rcvr);
+				return;
+			}
+			rcvr.multishot = false;
+			rcvr.rbuf = new uint8_t[bufsize];
+			break;
+		case EAGAIN :
+		case EINTR :
+		case ENOBUFS :			// All provided buffers busy
+			break;
+		default :			// I/O error (e.g. unplugged)
+			retire(rcvr);
+			return;
+		}
+	}
+	arm(user_data >> 8);
+#else
+	(void)user_data;
+	(void)res;
+	(void)flags;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Submit queued entries, wait up to ms for at least one completion
+// (0 = don't wait, -1 = no limit) and handle all completions. A
+// kernel without IORING_FEAT_EXT_ARG (< 5.11) cannot time out the
+// wait, so partial packets there only expire on the next data.
+//
+// This is the only place completions are reaped: entries queued by
+// complete() and handlers are flushed by claim_sqe() or the next call.
+//
+// RETURNS:
+//	0	- ok
+//	-1	- io_uring_enter() failed (errno set)
+//////////////////////////////////////////////////////////////////////
+
+int
+UringReactor::submit(int ms) {
+#ifdef TSIP_URING
+	struct io_uring_getevents_arg arg;
+	struct __kernel_timespec ts;
+	unsigned head;
+	int rc;
+
+	if ( deferred )
+		retry();
+
+	memset(&arg,0,sizeof arg);
+	if ( ms > 0 && ring->ext_arg ) {
+		ts.tv_sec = ms / 1000;
+		ts.tv_nsec = (ms % 1000) * 1000000L;
+		arg.ts = (uint64_t)(uintptr_t)&ts;
+	}
+
+	do	{
+		if ( ms == 0 )
+			rc = sys_enter(ring->fd,sq_pending(ring),0,0,0,0);
+		else if ( ms > 0 && ring->ext_arg )
+			rc = sys_enter(ring->fd,sq_pending(ring),1,
+				IORING_ENTER_GETEVENTS|IORING_ENTER_EXT_ARG,&arg,sizeof arg);
+		else	rc = sys_enter(ring->fd,sq_pending(ring),1,IORING_ENTER_GETEVENTS,0,0);
+		++enters;
+	} while ( rc < 0 && errno == EINTR );
+
+	if ( rc < 0 && errno != ETIME && errno != EBUSY )
+		return -1;			// EBUSY: CQ overflowed, reap it
+
+	// complete() may queue and flush entries, never reap: cq_head
+	// is only advanced here, so head stays current
+	head = *ring->cq_head;
+
+	while ( head != __atomic_load_n(ring->cq_tail,__ATOMIC_ACQUIRE) ) {
+		struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+		uint64_t user_data = cqe->user_data;
+		int res = cqe->res;
+		unsigned flags = cqe->flags;
+
+		__atomic_store_n(ring->cq_head,++head,__ATOMIC_RELEASE);
+		complete(user_data,res,flags);
+	}
+
+	if ( deferred )
+		retry();			// Submitted by the next call
+	return 0;
+#else
+	(void)ms;
+	return -1;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Milliseconds until the nearest partial packet times out, or -1
+//////////////////////////////////////////////////////////////////////
+
+int
+UringReactor::timeout() {
+	int ms = -1, left;
+
+	for ( int x=0; x<nrcvrs; ++x ) {
+		if ( !rcvrs[x].active )
+			continue;
+		left = rcvrs[x].pkt->gap_left();
+		if ( left >= 0 && (ms < 0 || left < ms) )
+			ms = left;
+	}
+	return ms;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Submit, wait up to ms (-1 = until data or a gap timeout) and
+// service all completions
+//
+// RETURNS:
+//	>= 0	- Number of packets dispatched
+//	-1	- No active receivers left, or io_uring_enter() failed
+//		  (errno set)
+//////////////////////////////////////////////////////////////////////
+
+int
+UringReactor::run_once(int ms) {
+	unsigned long before = dispatched;
+	int gap;
+
+	if ( !ring || nactive <= 0 )
+		return -1;
+
+	gap = timeout();
+	if ( gap >= 0 && (ms < 0 || gap < ms) )
+		ms = gap;
+
+	if ( submit(ms) < 0 )
+		return -1;
+
+	if ( gap >= 0 ) {
+		for ( int x=0; x<nrcvrs; ++x )
+			if ( rcvrs[x].active )
+				rcvrs[x].pkt->expire(deliver,&rcvrs[x]);
+	}
+
+	return int(dispatched - before);
+}
+
+void
+UringReactor::run() {
+
+	stopping = false;
+	while ( !stopping && run_once() >= 0 )
+		;
+}
+
+// End uring.cpp
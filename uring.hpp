@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////
+// uring.hpp -- io_uring Reactor for Many Receivers
+// Date: Sun Oct 18 14:02:33 2026
+///////////////////////////////////////////////////////////////////////
+
+#ifndef URING_HPP
+#define URING_HPP
+
+#include <stdint.h>
+
+#include "ttyio.hpp"
+#include "tsip.hpp"
+#include "reactor.hpp"
+
+struct s_uring;
+struct s_wqueue;
+
+//////////////////////////////////////////////////////////////////////
+// io_uring alternative to Reactor. Each receiver keeps a read
+// outstanding at all times: a multishot read into kernel-selected
+// buffers on pollable fds (ttys, pipes, sockets), or a re-armed read
+// at the current file position on capture files. Completions are
+// framed straight out of the completion buffer. Command frames are
+// queued per receiver and go out in order, as one writev() at a time;
+// a short write is resumed where it stopped.
+//
+// Handlers may call put() (and completions re-arm reads) while
+// completions are being handled: these only queue entries and flush
+// the submission queue. Completions are reaped only by run_once().
+//
+// open() returns false when io_uring is not available (no kernel
+// header at build time, or no kernel support at run time); use
+// Reactor instead. Multishot reads fall back to re-armed reads on
+// kernels older than 6.7.
+//////////////////////////////////////////////////////////////////////
+
+class UringReactor {
+	struct s_receiver {
+		UringReactor	*reactor;
+		Packet		*pkt;
+		rxhandler_t	handler;
+		void		*arg;
+		RxPacket	rxpkt;
+		uint8_t		*rbuf;		// Read buffer (if not multishot)
+		bool		multishot;	// Using provided buffers
+		bool		armed;		// Read outstanding
+		bool		active;		// Registered and not at EOF
+		bool		arm_due;	// arm() found the SQ full
+		bool		write_due;	// start_write() found the SQ full
+		s_wqueue	*wq;		// Frames queued for writing
+		int		writes;		// Frames not yet written
+	};
+
+	s_uring	*ring;		// Kernel ring mappings
+	s_receiver *rcvrs;	// Receiver table
+	int	maxrcvrs;	// Size of rcvrs[]
+	int	nrcvrs;		// Receivers added
+	int	nactive;	// Receivers not at EOF
+	bool	stopping;	// stop() called
+	unsigned long dispatched; // Packets passed to handlers
+	unsigned long enters;	// io_uring_enter(2) calls
+	unsigned long wr_errors; // Failed writes (frames dropped)
+	unsigned long short_wr;	// Writes resumed after a short write
+	bool	deferred;	// Some arm_due or write_due set
+
+protected:
+	static void deliver(void *arg,uint8_t *packet,int length,bool ended);
+	void arm(int rx);			// Queue a read for receiver
+	void start_write(int rx);		// Queue a writev of queued frames
+	void end_write(int rx,int res);		// Writev completed
+	void retry();				// Queue deferred reads and writes
+	void retire(s_receiver& rcvr);		// At EOF or error
+	void complete(uint64_t user_data,int res,unsigned flags);
+	int submit(int ms);			// Submit, wait, reap completions
+	int timeout();				// Nearest gap timeout (ms)
+
+public:	UringReactor();
+	~UringReactor();
+
+	bool open(int maxrcvrs=128,unsigned entries=256);
+	int add(Packet& pkt,rxhandler_t handler,void *arg=0);
+	inline RxPacket& rxpacket(int rx) { return rcvrs[rx].rxpkt; }
+
+	bool put(int rx,TxPacket *frames[],int count); // Frames kept until written
+	inline int writes(int rx) const { return rcvrs[rx].writes; }
+
+	int run_once(int ms=-1);		// One submit/wait round
+	void run();				// Until stop() or all at EOF
+	inline void stop() { stopping = true; }
+
+	inline int active() const { return nactive; }
+	inline unsigned long packets() const { return dispatched; }
+	inline unsigned long syscalls() const { return enters; }
+	inline unsigned long write_errors() const { return wr_errors; }
+	inline unsigned long short_writes() const { return short_wr; }
+};
+
+#endif // URING_HPP
+
+// End uring.hpp